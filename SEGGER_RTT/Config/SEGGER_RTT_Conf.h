@@ -57,6 +57,8 @@ Revision: $Rev: 24316 $
   #include <intrinsics.h>
 #endif
 
+#include "rtt_channels.h"     // Channel map and buffer count of the application
+
 /*********************************************************************
 *
 *       Defines, configurable
@@ -64,26 +66,54 @@ Revision: $Rev: 24316 $
 **********************************************************************
 */
 
+//
+// Memory budget profile for small-SRAM parts (RTT_MEMORY_BUDGET_EN, make
+// MEMORY_BUDGET=1): the terminal channel 0 is dropped.
+//
+#if (defined RTT_MEMORY_BUDGET_EN) && (RTT_MEMORY_BUDGET_EN != 0)
+  #define BUFFER_SIZE_UP                            (0)
+  #define BUFFER_SIZE_DOWN                          (0)
+#endif
+
+//
+// Fixed control block address (RTT_CB_ADDRESS, make RTT_CB_ADDRESS=<address>):
+// the control block gets its own NOBITS section, which the linker places at
+// RTT_CB_ADDRESS, so the J-Link does not search the RAM for it. As for the
+// deferred log strings, the trailing '@' comments out the section flags that
+// GCC appends. The terminal buffers stay in .bss.
+//
+#if (defined RTT_CB_ADDRESS) && (defined __GNUC__) && !(defined __clang__)
+  #define SEGGER_RTT_SECTION                        ".segger_rtt,\"aw\",%nobits @"
+  #define SEGGER_RTT_BUFFER_SECTION                 ".bss.segger_rtt_buffer"
+#endif
+
+//
+// Alignment of the RTT buffers of the application: one cache line when
+// SEGGER_RTT_CPU_CACHE_LINE_SIZE is set, otherwise one word for the
+// ARMv6-M copy routine
+//
+#define RTT_BUFFER_ALIGNMENT                        ((SEGGER_RTT_CPU_CACHE_LINE_SIZE > 4) ? SEGGER_RTT_CPU_CACHE_LINE_SIZE : 4)
+
 //
 // Take in and set to correct values for Cortex-A systems with CPU cache
 //
 //#define SEGGER_RTT_CPU_CACHE_LINE_SIZE            (32)          // Largest cache line size (in bytes) in the current system
 //#define SEGGER_RTT_UNCACHED_OFF                   (0xFB000000)  // Address alias where RTT CB and buffers can be accessed uncached
 //
-// Most common case:
-// Up-channel 0: RTT
-// Up-channel 1: SystemView
+// Number of buffers: sized to the highest channel used by the enabled features,
+// see rtt_channels.h for the channel map
+// Up-channel 0: terminal
+// Up-channel 1: tuner
 //
 #ifndef   SEGGER_RTT_MAX_NUM_UP_BUFFERS
-  #define SEGGER_RTT_MAX_NUM_UP_BUFFERS             (3)     // Max. number of up-buffers (T->H) available on this target    (Default: 3)
+  #define SEGGER_RTT_MAX_NUM_UP_BUFFERS             RTT_CHANNELS_NUM_UP     // Max. number of up-buffers (T->H) available on this target    (Default: 3)
 #endif
 //
-// Most common case:
-// Down-channel 0: RTT
-// Down-channel 1: SystemView
+// Down-channel 0: terminal
+// Down-channel 1: tuner commands
 //
 #ifndef   SEGGER_RTT_MAX_NUM_DOWN_BUFFERS
-  #define SEGGER_RTT_MAX_NUM_DOWN_BUFFERS           (3)     // Max. number of down-buffers (H->T) available on this target  (Default: 3)
+  #define SEGGER_RTT_MAX_NUM_DOWN_BUFFERS           RTT_CHANNELS_NUM_DOWN   // Max. number of down-buffers (H->T) available on this target  (Default: 3)
 #endif
 
 #ifndef   BUFFER_SIZE_UP
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * File Name: rtt_channels.h
+ *
+ * Description: This file contains the RTT channel map of the application,
+ * the number of RTT buffers derived from the enabled features, and the
+ * helpers the modules use to set up and write their record channels.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef RTT_CHANNELS_H
+#define RTT_CHANNELS_H
+
+/*******************************************************************************
+ * Channel map
+ ********************************************************************************/
+/* Up-buffers */
+#define RTT_TERMINAL_CHANNEL            0       /* printf() output */
+#define RTT_TUNER_CHANNEL               1       /* rtt_tuner.h */
+#define PROFILER_RTT_CHANNEL            2       /* profiler.h */
+#define TOUCH_EVENTS_RTT_CHANNEL        3       /* touch_events.h */
+#define DEFERRED_LOG_RTT_CHANNEL        4       /* deferred_log.h */
+#ifndef RTT_TUNER_SLOW_CHANNEL
+#define RTT_TUNER_SLOW_CHANNEL          5       /* rtt_tuner.h multi-rate output */
+#endif
+#define RAW_HISTORY_RTT_CHANNEL         6       /* raw_history.h */
+#define NOISE_METRICS_RTT_CHANNEL       7       /* noise_metrics.h */
+#define SIGNAL_STATS_RTT_CHANNEL        8       /* signal_stats.h */
+#define SCAN_STATUS_RTT_CHANNEL         9       /* scan_scheduler.h low-power status */
+
+/* Down-buffers: the terminal and tuner commands use the channel numbers of
+ * their up-buffers
+ */
+#ifndef RAW_HISTORY_DOWN_CHANNEL
+#define RAW_HISTORY_DOWN_CHANNEL        2       /* raw_history.h dump request */
+#endif
+
+/*******************************************************************************
+ * Number of buffers
+ ********************************************************************************/
+/* Sized to the highest channel used by the enabled features, so unused
+ * descriptors take no RAM and the J-Link does not scan them. Only features
+ * enabled on the command line (a make option or DEFINES) are seen here; a
+ * feature enabled in its header file stops the build in
+ * RTT_CHANNEL_CONFIG_UP() or RTT_CHANNEL_CONFIG_DOWN().
+ */
+#if   (defined SCAN_LOW_POWER_EN) && (SCAN_LOW_POWER_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (SCAN_STATUS_RTT_CHANNEL + 1)
+#elif (defined SIGNAL_STATS_EN) && (SIGNAL_STATS_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (SIGNAL_STATS_RTT_CHANNEL + 1)
+#elif (defined NOISE_METRICS_EN) && (NOISE_METRICS_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (NOISE_METRICS_RTT_CHANNEL + 1)
+#elif (defined RAW_HISTORY_EN) && (RAW_HISTORY_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (RAW_HISTORY_RTT_CHANNEL + 1)
+#elif (defined RTT_TUNER_MULTIRATE_EN) && (RTT_TUNER_MULTIRATE_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (RTT_TUNER_SLOW_CHANNEL + 1)
+#elif (defined DEFERRED_LOG_EN) && (DEFERRED_LOG_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (DEFERRED_LOG_RTT_CHANNEL + 1)
+#elif (defined TOUCH_EVENTS_EN) && (TOUCH_EVENTS_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (TOUCH_EVENTS_RTT_CHANNEL + 1)
+#elif (defined PROFILER_EN) && (PROFILER_EN != 0)
+#define RTT_CHANNELS_NUM_UP             (PROFILER_RTT_CHANNEL + 1)
+#else
+#define RTT_CHANNELS_NUM_UP             (RTT_TUNER_CHANNEL + 1)
+#endif
+
+#if   (defined RAW_HISTORY_EN) && (RAW_HISTORY_EN != 0)
+#define RTT_CHANNELS_NUM_DOWN           (RAW_HISTORY_DOWN_CHANNEL + 1)
+#else
+#define RTT_CHANNELS_NUM_DOWN           (RTT_TUNER_CHANNEL + 1)
+#endif
+
+/*******************************************************************************
+ * Record channel helpers
+ ********************************************************************************/
+/* Declares the up-buffer of a channel holding size bytes. RTT keeps one byte
+ * of the ring free, so the buffer is one byte larger. The alignment is the
+ * one of the RTT buffers, see SEGGER_RTT_Conf.h.
+ */
+#define RTT_CHANNEL_BUFFER(name, size) \
+    CY_ALIGN(RTT_BUFFER_ALIGNMENT) static uint8_t name[(size) + 1u]
+
+/* Configures an up-buffer or down-buffer after checking that the buffer
+ * count covers its channel. SEGGER_RTT_Init() must have been called before.
+ */
+#define RTT_CHANNEL_CONFIG_UP(channel, name, buffer, flags) \
+    do { \
+        _Static_assert((channel) < SEGGER_RTT_MAX_NUM_UP_BUFFERS, \
+            #channel " exceeds SEGGER_RTT_MAX_NUM_UP_BUFFERS, enable the feature on the command line"); \
+        (void)SEGGER_RTT_ConfigUpBuffer((channel), (name), (buffer), sizeof(buffer), (flags)); \
+    } while (0)
+
+#define RTT_CHANNEL_CONFIG_DOWN(channel, name, buffer, flags) \
+    do { \
+        _Static_assert((channel) < SEGGER_RTT_MAX_NUM_DOWN_BUFFERS, \
+            #channel " exceeds SEGGER_RTT_MAX_NUM_DOWN_BUFFERS, enable the feature on the command line"); \
+        (void)SEGGER_RTT_ConfigDownBuffer((channel), (name), (buffer), sizeof(buffer), (flags)); \
+    } while (0)
+
+/* Record channels configured with SEGGER_RTT_FLAG_SINGLE_WRITER are written
+ * only by the main loop, so the write needs no lock. A record is written
+ * completely or skipped when the up-buffer is full.
+ */
+#define RTT_CHANNEL_WRITE(channel, record, size) \
+    ((void)SEGGER_RTT_WriteLockFree((channel), (record), (size)))
+
+/* Flags of such a record channel */
+#define RTT_CHANNEL_RECORD_FLAGS        (SEGGER_RTT_MODE_NO_BLOCK_SKIP | SEGGER_RTT_FLAG_SINGLE_WRITER)
+
+#endif /* RTT_CHANNELS_H */
+
+
+/* [] END OF FILE */
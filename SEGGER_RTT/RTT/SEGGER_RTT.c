@@ -128,7 +128,15 @@ Additional information:
 #endif
 
 #ifndef   SEGGER_RTT_BUFFER_ALIGNMENT
-  #define SEGGER_RTT_BUFFER_ALIGNMENT                     SEGGER_RTT_CPU_CACHE_LINE_SIZE
+  #if SEGGER_RTT_MEMCPY_USE_ASM_ARMV6M
+    #define SEGGER_RTT_BUFFER_ALIGNMENT                   4   // Word aligned buffers for the ARMv6M copy fast path
+  #else
+    #define SEGGER_RTT_BUFFER_ALIGNMENT                   SEGGER_RTT_CPU_CACHE_LINE_SIZE
+  #endif
+#endif
+
+#ifndef   SEGGER_RTT_ALIGN_UP_BUFFERS
+  #define SEGGER_RTT_ALIGN_UP_BUFFERS                     SEGGER_RTT_MEMCPY_USE_ASM_ARMV6M  // 1: Up-buffers configured at run-time start on a word boundary
 #endif
 
 #ifndef   SEGGER_RTT_MODE_DEFAULT
@@ -156,7 +164,9 @@ Additional information:
 #endif
 
 #ifndef   SEGGER_RTT_MEMCPY
-  #ifdef  MEMCPY
+  #if SEGGER_RTT_MEMCPY_USE_ASM_ARMV6M
+    #define SEGGER_RTT_MEMCPY(pDest, pSrc, NumBytes)      SEGGER_RTT_ASM_ARMv6M_memcpy((pDest), (pSrc), (NumBytes))
+  #elif defined(MEMCPY)
     #define SEGGER_RTT_MEMCPY(pDest, pSrc, NumBytes)      MEMCPY((pDest), (pSrc), (NumBytes))
   #else
     #define SEGGER_RTT_MEMCPY(pDest, pSrc, NumBytes)      memcpy((pDest), (pSrc), (NumBytes))
@@ -264,16 +274,25 @@ static unsigned char _aTerminalId[16] = { '0', '1', '2', '3', '4', '5', '6', '7'
 //
 #if SEGGER_RTT_CPU_CACHE_LINE_SIZE
   #if ((defined __GNUC__) || (defined __clang__))
-    SEGGER_RTT_CB _SEGGER_RTT                                                             __attribute__ ((aligned (SEGGER_RTT_CPU_CACHE_LINE_SIZE)));
-    static char   _acUpBuffer  [SEGGER_RTT__ROUND_UP_2_CACHE_LINE_SIZE(BUFFER_SIZE_UP)]   __attribute__ ((aligned (SEGGER_RTT_CPU_CACHE_LINE_SIZE)));
-    static char   _acDownBuffer[SEGGER_RTT__ROUND_UP_2_CACHE_LINE_SIZE(BUFFER_SIZE_DOWN)] __attribute__ ((aligned (SEGGER_RTT_CPU_CACHE_LINE_SIZE)));
+    // The sections of SEGGER_RTT_SECTION and SEGGER_RTT_BUFFER_SECTION apply here as well
+    SEGGER_RTT_PUT_CB_SECTION(SEGGER_RTT_CB _SEGGER_RTT                                                                   __attribute__ ((aligned (SEGGER_RTT_CPU_CACHE_LINE_SIZE))));
+    #if BUFFER_SIZE_UP
+    SEGGER_RTT_PUT_BUFFER_SECTION(static char   _acUpBuffer  [SEGGER_RTT__ROUND_UP_2_CACHE_LINE_SIZE(BUFFER_SIZE_UP)]   __attribute__ ((aligned (SEGGER_RTT_CPU_CACHE_LINE_SIZE))));
+    #endif
+    #if BUFFER_SIZE_DOWN
+    SEGGER_RTT_PUT_BUFFER_SECTION(static char   _acDownBuffer[SEGGER_RTT__ROUND_UP_2_CACHE_LINE_SIZE(BUFFER_SIZE_DOWN)] __attribute__ ((aligned (SEGGER_RTT_CPU_CACHE_LINE_SIZE))));
+    #endif
   #else
     #error "Don't know how to place _SEGGER_RTT, _acUpBuffer, _acDownBuffer cache-line aligned"
   #endif
 #else
   SEGGER_RTT_PUT_CB_SECTION(SEGGER_RTT_CB_ALIGN(SEGGER_RTT_CB _SEGGER_RTT));
+  #if BUFFER_SIZE_UP
   SEGGER_RTT_PUT_BUFFER_SECTION(SEGGER_RTT_BUFFER_ALIGN(static char _acUpBuffer  [BUFFER_SIZE_UP]));
+  #endif
+  #if BUFFER_SIZE_DOWN
   SEGGER_RTT_PUT_BUFFER_SECTION(SEGGER_RTT_BUFFER_ALIGN(static char _acDownBuffer[BUFFER_SIZE_DOWN]));
+  #endif
 #endif
 
 static unsigned char _ActiveTerminal;
@@ -316,23 +335,28 @@ static void _DoInit(void) {
   p->MaxNumUpBuffers    = SEGGER_RTT_MAX_NUM_UP_BUFFERS;
   p->MaxNumDownBuffers  = SEGGER_RTT_MAX_NUM_DOWN_BUFFERS;
   //
-  // Initialize up buffer 0
+  // Initialize up buffer 0. With BUFFER_SIZE_UP 0, the terminal is dropped and
+  // the descriptor stays zero, which J-Link treats as an unused buffer.
   //
+#if BUFFER_SIZE_UP
   p->aUp[0].sName         = "Terminal";
   p->aUp[0].pBuffer       = _acUpBuffer;
   p->aUp[0].SizeOfBuffer  = BUFFER_SIZE_UP;
   p->aUp[0].RdOff         = 0u;
   p->aUp[0].WrOff         = 0u;
   p->aUp[0].Flags         = SEGGER_RTT_MODE_DEFAULT;
+#endif
   //
   // Initialize down buffer 0
   //
+#if BUFFER_SIZE_DOWN
   p->aDown[0].sName         = "Terminal";
   p->aDown[0].pBuffer       = _acDownBuffer;
   p->aDown[0].SizeOfBuffer  = BUFFER_SIZE_DOWN;
   p->aDown[0].RdOff         = 0u;
   p->aDown[0].WrOff         = 0u;
   p->aDown[0].Flags         = SEGGER_RTT_MODE_DEFAULT;
+#endif
   //
   // Finish initialization of the control block.
   // Copy Id string backwards to make sure that "SEGGER RTT" is not found in initializer memory (usually flash),
@@ -534,6 +558,31 @@ static unsigned _GetAvailWriteSpace(SEGGER_RTT_BUFFER_UP* pRing) {
   return r;
 }
 
+#if SEGGER_RTT_ALIGN_UP_BUFFERS
+/*********************************************************************
+*
+*       _AlignUpBuffer()
+*
+*  Function description
+*    Moves the start of a buffer provided at run-time to the next word
+*    boundary, so that ring writes reach the word copy fast path.
+*    The usable size shrinks by the skipped bytes.
+*
+*  Parameters
+*    ppBuffer     Pointer to the buffer start, updated.
+*    pBufferSize  Pointer to the buffer size, updated.
+*/
+static void _AlignUpBuffer(void** ppBuffer, unsigned* pBufferSize) {
+  unsigned Skip;
+
+  Skip = (0u - (unsigned)(unsigned long)*ppBuffer) & 3u;  // Bytes up to the next word boundary
+  if (*pBufferSize > Skip) {
+    *ppBuffer     = (char*)*ppBuffer + Skip;
+    *pBufferSize -= Skip;
+  }
+}
+#endif
+
 /*********************************************************************
 *
 *       Public code
@@ -951,7 +1000,7 @@ unsigned SEGGER_RTT_WriteSkipNoLock(unsigned BufferIndex, const void* pBuffer, u
     if (Avail >= NumBytes) {                            // Case 1)?
 CopyStraight:
       pDst = (pRing->pBuffer + WrOff) + SEGGER_RTT_UNCACHED_OFF;
-      memcpy((void*)pDst, pData, NumBytes);
+      SEGGER_RTT_MEMCPY((void*)pDst, pData, NumBytes);
       RTT__DMB();                     // Force data write to be complete before writing the <WrOff>, in case CPU is allowed to change the order of memory accesses
       pRing->WrOff = WrOff + NumBytes;
       return 1;
@@ -960,7 +1009,7 @@ CopyStraight:
     if (Avail >= NumBytes) {                            // Case 2? => If not, we have case 3) (does not fit)
       Rem = pRing->SizeOfBuffer - WrOff;                // Space until end of buffer
       pDst = (pRing->pBuffer + WrOff) + SEGGER_RTT_UNCACHED_OFF;
-      memcpy((void*)pDst, pData, Rem);                  // Copy 1st chunk
+      SEGGER_RTT_MEMCPY((void*)pDst, pData, Rem);       // Copy 1st chunk
       NumBytes -= Rem;
       //
       // Special case: First check that assumed RdOff == 0 calculated that last element before wrap-around could not be used
@@ -970,7 +1019,7 @@ CopyStraight:
       //
       if (NumBytes) {
         pDst = pRing->pBuffer + SEGGER_RTT_UNCACHED_OFF;
-        memcpy((void*)pDst, pData + Rem, NumBytes);
+        SEGGER_RTT_MEMCPY((void*)pDst, pData + Rem, NumBytes);
       }
       RTT__DMB();                     // Force data write to be complete before writing the <WrOff>, in case CPU is allowed to change the order of memory accesses
       pRing->WrOff = NumBytes;
@@ -1102,7 +1151,7 @@ unsigned SEGGER_RTT_WriteNoLock(unsigned BufferIndex, const void* pBuffer, unsig
   //
   // How we output depends upon the mode...
   //
-  switch (pRing->Flags) {
+  switch (pRing->Flags & SEGGER_RTT_MODE_MASK) {
   case SEGGER_RTT_MODE_NO_BLOCK_SKIP:
     //
     // If we are in skip mode and there is no space for the whole
@@ -1197,6 +1246,14 @@ unsigned SEGGER_RTT_WriteDownBuffer(unsigned BufferIndex, const void* pBuffer, u
 unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void* pBuffer, unsigned NumBytes) {
   unsigned Status;
 
+#if (BUFFER_SIZE_UP == 0)
+  //
+  // Terminal dropped: discard printf() and SEGGER_RTT_WriteString() output
+  //
+  if (BufferIndex == 0u) {
+    return 0u;
+  }
+#endif
   INIT();
   SEGGER_RTT_LOCK();
   Status = SEGGER_RTT_WriteNoLock(BufferIndex, pBuffer, NumBytes);  // Call the non-locking write function
@@ -1204,6 +1261,52 @@ unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void* pBuffer, unsigned Nu
   return Status;
 }
 
+/*********************************************************************
+*
+*       SEGGER_RTT_WriteLockFree
+*
+*  Function description
+*    Stores a specified number of characters in SEGGER RTT
+*    control block which is then read by the host.
+*    If the buffer has been configured with SEGGER_RTT_FLAG_SINGLE_WRITER,
+*    the data is written without locking: the writer owns <WrOff>,
+*    J-Link owns <RdOff>, and <WrOff> is only published after the data,
+*    ordered by RTT__DMB(). Otherwise, this function locks like
+*    SEGGER_RTT_Write().
+*
+*  Parameters
+*    BufferIndex  Index of "Up"-buffer to be used (e.g. 0 for "Terminal").
+*    pBuffer      Pointer to character array. Does not need to point to a \0 terminated string.
+*    NumBytes     Number of bytes to be stored in the SEGGER RTT control block.
+*
+*  Return value
+*    Number of bytes which have been stored in the "Up"-buffer.
+*
+*  Notes
+*    (1) Data is stored according to buffer flags.
+*    (2) For performance reasons this function does not call Init()
+*        and may only be called after RTT has been initialized.
+*        Either by calling SEGGER_RTT_Init() or calling another RTT API function first.
+*    (3) A single-writer buffer must only be written from one context,
+*        e.g. one interrupt handler or the main loop, and only through
+*        the NoLock or LockFree functions. Do not combine the flag with
+*        SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL when writing from an interrupt.
+*/
+unsigned SEGGER_RTT_WriteLockFree(unsigned BufferIndex, const void* pBuffer, unsigned NumBytes) {
+  unsigned              Status;
+  SEGGER_RTT_BUFFER_UP* pRing;
+
+  pRing = (SEGGER_RTT_BUFFER_UP*)((char*)&_SEGGER_RTT.aUp[BufferIndex] + SEGGER_RTT_UNCACHED_OFF);  // Access uncached to make sure we see changes made by the J-Link side and all of our changes go into HW directly
+  if ((pRing->Flags & SEGGER_RTT_FLAG_SINGLE_WRITER) != 0u) {
+    Status = SEGGER_RTT_WriteNoLock(BufferIndex, pBuffer, NumBytes);  // No other writer, no need to lock
+  } else {
+    SEGGER_RTT_LOCK();
+    Status = SEGGER_RTT_WriteNoLock(BufferIndex, pBuffer, NumBytes);  // Shared buffer, lock against other writers
+    SEGGER_RTT_UNLOCK();
+  }
+  return Status;
+}
+
 /*********************************************************************
 *
 *       SEGGER_RTT_WriteString
@@ -1387,7 +1490,7 @@ unsigned SEGGER_RTT_PutChar(unsigned BufferIndex, char c) {
   //
   // Wait for free space if mode is set to blocking
   //
-  if (pRing->Flags == SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL) {
+  if ((pRing->Flags & SEGGER_RTT_MODE_MASK) == SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL) {
     while (WrOff == pRing->RdOff) {
       ;
     }
@@ -1607,6 +1710,9 @@ int SEGGER_RTT_AllocUpBuffer(const char* sName, void* pBuffer, unsigned BufferSi
   volatile SEGGER_RTT_CB* pRTTCB;
 
   INIT();
+#if SEGGER_RTT_ALIGN_UP_BUFFERS
+  _AlignUpBuffer(&pBuffer, &BufferSize);
+#endif
   SEGGER_RTT_LOCK();
   pRTTCB = (volatile SEGGER_RTT_CB*)((unsigned char*)&_SEGGER_RTT + SEGGER_RTT_UNCACHED_OFF);  // Access RTTCB uncached to make sure we see changes made by the J-Link side and all of our changes go into HW directly
   BufferIndex = 0;
@@ -1664,6 +1770,9 @@ int SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char* sName, void* pBu
   INIT();
   pRTTCB = (volatile SEGGER_RTT_CB*)((unsigned char*)&_SEGGER_RTT + SEGGER_RTT_UNCACHED_OFF);  // Access RTTCB uncached to make sure we see changes made by the J-Link side and all of our changes go into HW directly
   if (BufferIndex < SEGGER_RTT_MAX_NUM_UP_BUFFERS) {
+#if SEGGER_RTT_ALIGN_UP_BUFFERS
+    _AlignUpBuffer(&pBuffer, &BufferSize);
+#endif
     SEGGER_RTT_LOCK();
     pUp = &pRTTCB->aUp[BufferIndex];
     if (BufferIndex) {
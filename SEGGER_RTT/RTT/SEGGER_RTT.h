@@ -62,6 +62,24 @@ Revision: $Rev: 24346 $
 **********************************************************************
 */
 
+//
+// ARMv6M (Cortex-M0/M0+/M1) only has Thumb-1 instructions, so it uses its own
+// assembler module (SEGGER_RTT_ASM_ARMv6M.S) instead of SEGGER_RTT_ASM_ARMv7M.S.
+//
+#ifndef SEGGER_RTT_CORE_ARMV6M
+  #if (defined __ARM_ARCH_6M__)                   // GCC, clang, ARM compiler V6
+    #define SEGGER_RTT_CORE_ARMV6M                (1)
+  #elif (defined __ARM6M__) && (defined __CORE__) // IAR
+    #if (__CORE__ == __ARM6M__)
+      #define SEGGER_RTT_CORE_ARMV6M              (1)
+    #else
+      #define SEGGER_RTT_CORE_ARMV6M              (0)
+    #endif
+  #else
+    #define SEGGER_RTT_CORE_ARMV6M                (0)
+  #endif
+#endif
+
 #ifndef RTT_USE_ASM
   //
   // Some cores support out-of-order memory accesses (reordering of memory accesses in the core)
@@ -106,7 +124,7 @@ Revision: $Rev: 24346 $
       #define _CC_HAS_RTT_ASM_SUPPORT 0
     #endif
     #if (defined __ARM_ARCH_6M__)                 // Cortex-M0 / M1
-      #define _CORE_HAS_RTT_ASM_SUPPORT 0         // No ASM support for this architecture
+      #define _CORE_HAS_RTT_ASM_SUPPORT 1
     #elif (defined __ARM_ARCH_7M__)               // Cortex-M3
       #define _CORE_HAS_RTT_ASM_SUPPORT 1
     #elif (defined __ARM_ARCH_7EM__)              // Cortex-M4/M7
@@ -133,7 +151,9 @@ Revision: $Rev: 24346 $
     //
     #define _CC_HAS_RTT_ASM_SUPPORT 1
     // ARM 7/9: __ARM_ARCH_5__ / __ARM_ARCH_5E__ / __ARM_ARCH_5T__ / __ARM_ARCH_5T__ / __ARM_ARCH_5TE__
-    #if (defined __ARM_ARCH_7M__)                 // Cortex-M3
+    #if (defined __ARM_ARCH_6M__)                 // Cortex-M0/M0+/M1
+      #define _CORE_HAS_RTT_ASM_SUPPORT 1
+    #elif (defined __ARM_ARCH_7M__)               // Cortex-M3
       #define _CORE_HAS_RTT_ASM_SUPPORT 1
     #elif (defined __ARM_ARCH_7EM__)              // Cortex-M4/M7
       #define _CORE_HAS_RTT_ASM_SUPPORT 1
@@ -163,6 +183,11 @@ Revision: $Rev: 24346 $
     #else
       #define VOLATILE volatile
     #endif
+    #if (defined __ARM6M__)
+      #if (__CORE__ == __ARM6M__)                      // Cortex-M0/M0+/M1
+        #define _CORE_HAS_RTT_ASM_SUPPORT 1
+      #endif
+    #endif
     #if (defined __ARM7M__)                            // Needed for old versions that do not know the define yet
       #if (__CORE__ == __ARM7M__)                      // Cortex-M3
         #define _CORE_HAS_RTT_ASM_SUPPORT 1
@@ -230,6 +255,18 @@ Revision: $Rev: 24346 $
   #endif
 #endif
 
+//
+// ARMv6M (Cortex-M0/M0+/M1) cannot access unaligned words, so the toolchain memcpy()
+// falls back to byte copies for most ring positions. Use the ARMv6M copy routine instead.
+//
+#ifndef SEGGER_RTT_MEMCPY_USE_ASM_ARMV6M
+  #if ((defined __SES_ARM) || (defined __GNUC__) || (defined __clang__) || (defined __IASMARM__) || (defined __ICCARM__)) && (SEGGER_RTT_CORE_ARMV6M == 1)
+    #define SEGGER_RTT_MEMCPY_USE_ASM_ARMV6M      (1)
+  #else
+    #define SEGGER_RTT_MEMCPY_USE_ASM_ARMV6M      (0)
+  #endif
+#endif
+
 #ifndef _CORE_NEEDS_DMB
   #define _CORE_NEEDS_DMB 0
 #endif
@@ -369,8 +406,10 @@ int          SEGGER_RTT_SetFlagsUpBuffer        (unsigned BufferIndex, unsigned
 int          SEGGER_RTT_WaitKey                 (void);
 unsigned     SEGGER_RTT_Write                   (unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
 unsigned     SEGGER_RTT_WriteNoLock             (unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
+unsigned     SEGGER_RTT_WriteLockFree           (unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
 unsigned     SEGGER_RTT_WriteSkipNoLock         (unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
 unsigned     SEGGER_RTT_ASM_WriteSkipNoLock     (unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
+void         SEGGER_RTT_ASM_ARMv6M_memcpy       (void* pDest, const void* pSrc, unsigned NumBytes);
 unsigned     SEGGER_RTT_WriteString             (unsigned BufferIndex, const char* s);
 void         SEGGER_RTT_WriteWithOverwriteNoLock(unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
 unsigned     SEGGER_RTT_PutChar                 (unsigned BufferIndex, char c);
@@ -439,6 +478,11 @@ int SEGGER_RTT_vprintf(unsigned BufferIndex, const char * sFormat, va_list * pPa
 #define SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL    (2)     // Block: Wait until there is space in the buffer.
 #define SEGGER_RTT_MODE_MASK                  (3)
 
+//
+// Buffer flags, may be combined with one of the operating modes above
+//
+#define SEGGER_RTT_FLAG_SINGLE_WRITER         (4)     // Single writer: only one context writes this up-buffer, see SEGGER_RTT_WriteLockFree()
+
 //
 // Control sequences, based on ANSI.
 // Can be used to control color, and clear the screen
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * File Name: deferred_log.c
+ *
+ * Description: This file contains the deferred logger. Each log writes a
+ * record with the format string ID, a timestamp and the raw arguments
+ * to an RTT up-buffer. The host formats it from the strings in the ELF file.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "deferred_log.h"
+
+#if (0u != DEFERRED_LOG_EN)
+#include "timestamp.h"
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+RTT_CHANNEL_BUFFER(deferred_log_up_buf, DEFERRED_LOG_BUF_SIZE);
+
+/* Records skipped since the last record that fitted */
+static uint32_t deferred_log_dropped = 0u;
+
+/* Set once the up-buffer is configured. The control block is not checked, as
+ * it is not zero-initialized at startup with RTT_CB_ADDRESS.
+ */
+static bool deferred_log_ready = false;
+
+
+/*******************************************************************************
+ * Function Name: deferred_log_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the log up-buffer. SEGGER_RTT_Init() must have been called
+ *  before.
+ *
+ *******************************************************************************/
+void deferred_log_init(void)
+{
+    RTT_CHANNEL_CONFIG_UP(DEFERRED_LOG_RTT_CHANNEL, "log", deferred_log_up_buf, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    deferred_log_ready = true;
+}
+
+
+/*******************************************************************************
+ * Function Name: deferred_log_write
+ ********************************************************************************
+ * Summary:
+ *  Writes one log record: the header, the timestamp and the number of argument
+ *  words given in the header. A record that does not fit is dropped as a whole
+ *  and counted, and the count is written before the next record that fits.
+ *  Records written before deferred_log_init() are counted the same way.
+ *  Safe to call from interrupts. Use the DEFERRED_LOGn() macros instead of
+ *  calling this function directly.
+ *
+ * Parameters:
+ *  header: DEFERRED_LOG_HEADER() of the format record
+ *  arg0-arg3: arguments, unused ones are not written
+ *
+ *******************************************************************************/
+void deferred_log_write(uint32_t header, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+    uint32_t record[2u + DEFERRED_LOG_MAX_ARGS];
+    uint32_t size = (2u + (header >> DEFERRED_LOG_NARGS_POS)) * sizeof(uint32_t);
+
+    SEGGER_RTT_LOCK();
+
+    if (!deferred_log_ready)
+    {
+        deferred_log_dropped++;
+        SEGGER_RTT_UNLOCK();
+        return;
+    }
+
+    record[1] = timestamp_get();
+
+    if (0u != deferred_log_dropped)
+    {
+        record[0] = DEFERRED_LOG_HEADER(1u, DEFERRED_LOG_MODULE_DROPPED, 0u);
+        record[2] = deferred_log_dropped;
+        if (0u != SEGGER_RTT_WriteSkipNoLock(DEFERRED_LOG_RTT_CHANNEL, record, 3u * sizeof(uint32_t)))
+        {
+            deferred_log_dropped = 0u;
+        }
+    }
+
+    record[0] = header;
+    record[2] = arg0;
+    record[3] = arg1;
+    record[4] = arg2;
+    record[5] = arg3;
+
+    if ((0u != deferred_log_dropped) ||
+        (0u == SEGGER_RTT_WriteSkipNoLock(DEFERRED_LOG_RTT_CHANNEL, record, size)))
+    {
+        deferred_log_dropped++;
+    }
+
+    SEGGER_RTT_UNLOCK();
+}
+#endif /* DEFERRED_LOG_EN */
+
+
+/* [] END OF FILE */
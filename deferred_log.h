@@ -0,0 +1,150 @@
+/******************************************************************************
+ * File Name: deferred_log.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the deferred logger, which writes a format string ID and the raw
+ * argument words to an RTT up-buffer for the host to format.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Compile in the deferred logger */
+#ifndef DEFERRED_LOG_EN
+#define DEFERRED_LOG_EN                 (0u)
+#endif
+
+/* Number of bytes the up-buffer holds. A record takes 8 bytes plus 4 per
+ * argument.
+ */
+#ifndef DEFERRED_LOG_BUF_SIZE
+#define DEFERRED_LOG_BUF_SIZE           (256u)
+#endif
+
+/* Identifies the source file in the record header. Define a unique value
+ * (1 to 8190) before including this file in each file that logs.
+ */
+#ifndef DEFERRED_LOG_MODULE
+#define DEFERRED_LOG_MODULE             (0u)
+#endif
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Record header: bits 31:29 argument count, 28:16 module, 15:0 line */
+#define DEFERRED_LOG_MAX_ARGS           (4u)
+#define DEFERRED_LOG_NARGS_POS          (29u)
+#define DEFERRED_LOG_MODULE_POS         (16u)
+#define DEFERRED_LOG_MODULE_MASK        (0x1FFFu)
+#define DEFERRED_LOG_HEADER(nargs, module, line) \
+    (((uint32_t)(nargs) << DEFERRED_LOG_NARGS_POS) | \
+     (((uint32_t)(module) & DEFERRED_LOG_MODULE_MASK) << DEFERRED_LOG_MODULE_POS) | \
+     ((uint32_t)(line) & 0xFFFFu))
+
+/* Module of the record that reports the number of records dropped before it */
+#define DEFERRED_LOG_MODULE_DROPPED     (DEFERRED_LOG_MODULE_MASK)
+
+/* Format strings go to a section that is kept in the ELF file but not loaded,
+ * so they take no flash. The trailing '@' comments out the section flags that
+ * GCC appends. Other toolchains keep the strings in flash.
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#define DEFERRED_LOG_SECTION            __attribute__((section(".deferred_log,\"\",%progbits @"), used, aligned(4)))
+#else
+#define DEFERRED_LOG_SECTION            CY_SECTION(".deferred_log") CY_USED CY_ALIGN(4)
+#endif
+
+/* Format record read by the host: header, format string, file name. The code
+ * does not reference it, so it does not need to be loaded.
+ */
+#define DEFERRED_LOG_FORMAT(nargs, fmt) \
+    DEFERRED_LOG_SECTION static const struct \
+    { \
+        uint32_t header; \
+        char format[sizeof(fmt)]; \
+        char file[sizeof(__FILE__)]; \
+    } deferred_log_format = { DEFERRED_LOG_HEADER((nargs), DEFERRED_LOG_MODULE, __LINE__), fmt, __FILE__ }
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != DEFERRED_LOG_EN)
+void deferred_log_init(void);
+void deferred_log_write(uint32_t header, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/* printf-style logging with 0 to 4 integer or pointer arguments. The format
+ * string must be a literal. %s arguments must point to constant strings, which
+ * the host reads from the ELF file. Only one log per source line.
+ */
+#define DEFERRED_LOG_INIT()             deferred_log_init()
+#define DEFERRED_LOG0(fmt) \
+    do { DEFERRED_LOG_FORMAT(0u, fmt); \
+         deferred_log_write(DEFERRED_LOG_HEADER(0u, DEFERRED_LOG_MODULE, __LINE__), 0u, 0u, 0u, 0u); } while (0)
+#define DEFERRED_LOG1(fmt, a0) \
+    do { DEFERRED_LOG_FORMAT(1u, fmt); \
+         deferred_log_write(DEFERRED_LOG_HEADER(1u, DEFERRED_LOG_MODULE, __LINE__), (uint32_t)(a0), 0u, 0u, 0u); } while (0)
+#define DEFERRED_LOG2(fmt, a0, a1) \
+    do { DEFERRED_LOG_FORMAT(2u, fmt); \
+         deferred_log_write(DEFERRED_LOG_HEADER(2u, DEFERRED_LOG_MODULE, __LINE__), (uint32_t)(a0), (uint32_t)(a1), 0u, 0u); } while (0)
+#define DEFERRED_LOG3(fmt, a0, a1, a2) \
+    do { DEFERRED_LOG_FORMAT(3u, fmt); \
+         deferred_log_write(DEFERRED_LOG_HEADER(3u, DEFERRED_LOG_MODULE, __LINE__), (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), 0u); } while (0)
+#define DEFERRED_LOG4(fmt, a0, a1, a2, a3) \
+    do { DEFERRED_LOG_FORMAT(4u, fmt); \
+         deferred_log_write(DEFERRED_LOG_HEADER(4u, DEFERRED_LOG_MODULE, __LINE__), (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3)); } while (0)
+#else
+#define DEFERRED_LOG_INIT()
+#define DEFERRED_LOG0(fmt)
+#define DEFERRED_LOG1(fmt, a0)                  ((void)(a0))
+#define DEFERRED_LOG2(fmt, a0, a1)              ((void)(a0), (void)(a1))
+#define DEFERRED_LOG3(fmt, a0, a1, a2)          ((void)(a0), (void)(a1), (void)(a2))
+#define DEFERRED_LOG4(fmt, a0, a1, a2, a3)      ((void)(a0), (void)(a1), (void)(a2), (void)(a3))
+#endif
+
+#endif /* DEFERRED_LOG_H */
+
+
+/* [] END OF FILE */
@@ -46,39 +46,20 @@
 #include "cybsp.h"
 #include "cycfg.h"
 #include "cycfg_capsense.h"
-
-/*******************************************************************************
- * User configurable Macros/functions for RTT
- ********************************************************************************/
-#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+#include "rtt_tuner.h"
+#include "timestamp.h"
+#include "profiler.h"
+#include "touch_events.h"
+#include "slider_filter.h"
+#include "raw_history.h"
+#include "noise_metrics.h"
+#include "signal_stats.h"
+#include "tuning_store.h"
+#include "scan_scheduler.h"
+#define DEFERRED_LOG_MODULE              (1u)
+#include "deferred_log.h"
 #include <stdio.h>
 
-#define RTT_TUNER_CHANNEL 1
-#define RTT_USE_FAST_RTT  1
-
-#define RTT_TX_HEADER0      0x0Du
-#define RTT_TX_HEADER1      0x0Au
-
-#define RTT_TX_TAIL0        0x00u
-#define RTT_TX_TAIL1        0xFFu
-#define RTT_TX_TAIL2        0xFFu
-
-typedef struct {
-    uint8_t header[2];
-    uint8_t tuner_data[sizeof(cy_capsense_tuner)];
-    uint8_t tail[3];
-} rtt_tuner_data_t;
-
-static void rtt_tuner_send(void * context);
-static void rtt_tuner_receive(uint8_t ** packet, uint8_t ** tuner_packet, void * context);
-static uint8_t tuner_down_buf[32];
-
-static rtt_tuner_data_t tuner_up_buf = {
-    .header = {RTT_TX_HEADER0, RTT_TX_HEADER1},
-    .tuner_data = {0},
-    .tail = {RTT_TX_TAIL0, RTT_TX_TAIL1, RTT_TX_TAIL2}
-};
-
 
 /*******************************************************************************
  * Macros
@@ -86,12 +67,51 @@ static rtt_tuner_data_t tuner_up_buf = {
 #define CAPSENSE_INTR_PRIORITY           (3u)
 #define CY_ASSERT_FAILED                 (0u)
 
+/* Event-driven scanning: the CPU sleeps until the end-of-scan callback and
+ * processes widget N while the hardware scans widget N+1. When disabled, the
+ * main loop polls Cy_CapSense_IsBusy() and scans all widgets at once.
+ */
+#ifndef CAPSENSE_SCAN_PIPELINE_EN
+#define CAPSENSE_SCAN_PIPELINE_EN        (0u)
+#endif
+
+/* Fast start: the first scan starts right after the CAPSENSE is enabled, and
+ * RTT is configured while it runs. The tuner only runs once a host has read
+ * the tuner up-buffer or written to the tuner down-buffer, so units without
+ * a probe attached spend no time on tuner frames.
+ */
+#ifndef FAST_START_EN
+#define FAST_START_EN                    (0u)
+#endif
+
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN) && (0u != SCAN_SCHEDULER_EN)
+#error "SCAN_SCHEDULER_EN requires the polling main loop (CAPSENSE_SCAN_PIPELINE_EN = 0)"
+#endif
+
+#if (0u != SCAN_LOW_POWER_EN) && (0u == SCAN_SCHEDULER_EN)
+#error "SCAN_LOW_POWER_EN requires SCAN_SCHEDULER_EN"
+#endif
+
 /*******************************************************************************
  * Function Prototypes
  *******************************************************************************/
+static void initialize_rtt(void);
 static void initialize_capsense(void);
 static void capsense_isr(void);
 static void initialize_capsense_tuner(void);
+static void run_tuner(void);
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN)
+static void capsense_end_of_scan(cy_stc_active_scan_sns_t * ptrActiveScan);
+static void capsense_wait_for_scan(void);
+#endif
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN)
+/* Set by the end-of-scan callback in interrupt context */
+static volatile bool capsense_scan_done = false;
+#endif
 
 /*******************************************************************************
  * Function Name: main
@@ -110,13 +130,20 @@ static void initialize_capsense_tuner(void);
 int main(void)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
-
-    /* Initializes the RTT Control Block */
-    SEGGER_RTT_Init();
-    /* Configure or add an up buffer by specifying its name, size and flags */
-    SEGGER_RTT_ConfigUpBuffer(RTT_TUNER_CHANNEL, "tuner", &tuner_up_buf, sizeof(tuner_up_buf) + 1, SEGGER_RTT_MODE_NO_BLOCK_TRIM);
-    /* Configure or add a down buffer by specifying its name, size and flags */
-    SEGGER_RTT_ConfigDownBuffer(RTT_TUNER_CHANNEL, "tuner", tuner_down_buf, sizeof(tuner_down_buf), SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL);
+    uint32_t scan_start;
+    uint32_t cycle_start;
+    uint32_t stage_start;
+    uint32_t report_start;
+    uint32_t first_scan;
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN)
+    uint32_t widget_id = 0u;
+    uint32_t done_id;
+#endif
+
+#if (0u == FAST_START_EN)
+    /* Initialize RTT and its channels */
+    initialize_rtt();
+#endif
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -127,6 +154,9 @@ int main(void)
         CY_ASSERT(CY_ASSERT_FAILED);
     }
 
+    /* Start the timestamp used to tag RTT frames */
+    timestamp_init();
+
     /* Enable global interrupts */
     __enable_irq();
 
@@ -136,24 +166,253 @@ int main(void)
     /* Initialize CAPSENSE Tuner */
     initialize_capsense_tuner();
 
-    /* Start the first scan */
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN)
+    /* Start the first scan. The CAPSENSE interrupt writes the raw counts
+     * during the scan, so the tuner data is updated until the last widget
+     * is processed.
+     */
+    scan_start = PROFILER_MARK();
+    cycle_start = scan_start;
+    capsense_scan_done = false;
+    RTT_TUNER_UPDATE_BEGIN();
+    Cy_CapSense_ScanWidget(widget_id, &cy_capsense_context);
+    first_scan = timestamp_get();
+
+#if (0u != FAST_START_EN)
+    /* Initialize RTT while the first scan runs */
+    initialize_rtt();
+#endif
+    DEFERRED_LOG3("Started, %u widgets, core clock %u Hz, first scan after %u cycles",
+                  CY_CAPSENSE_WIDGET_COUNT, SystemCoreClock, first_scan);
+
+    for (;;)
+    {
+        capsense_wait_for_scan();
+        done_id = widget_id;
+
+        if ((done_id + 1u) < CY_CAPSENSE_WIDGET_COUNT)
+        {
+            /* Scan the next widget while this one is processed */
+            widget_id = done_id + 1u;
+            capsense_scan_done = false;
+            Cy_CapSense_ScanWidget(widget_id, &cy_capsense_context);
+
+            stage_start = PROFILER_MARK();
+            Cy_CapSense_ProcessWidget(done_id, &cy_capsense_context);
+            PROFILER_RECORD(PROFILER_STAGE_PROCESS, stage_start);
+        }
+        else
+        {
+            PROFILER_RECORD(PROFILER_STAGE_SCAN, scan_start);
+            report_start = PROFILER_MARK();
+
+            /* Last widget: the hardware is idle, so the tuner sees a
+             * consistent frame and may safely apply commands.
+             */
+            stage_start = PROFILER_MARK();
+            Cy_CapSense_ProcessWidget(done_id, &cy_capsense_context);
+            RTT_TUNER_UPDATE_END();
+            PROFILER_RECORD(PROFILER_STAGE_PROCESS, stage_start);
+
+#if (0u != SLIDER_FILTER_EN)
+            /* Filter the slider positions */
+            stage_start = PROFILER_MARK();
+            slider_filter_update(&cy_capsense_context);
+            PROFILER_RECORD(PROFILER_STAGE_FILTER, stage_start);
+#endif
+
+#if (0u != TOUCH_EVENTS_EN)
+            /* Report button and slider changes */
+            touch_events_update(&cy_capsense_context);
+#endif
+
+#if (0u != RAW_HISTORY_EN)
+            /* Record the counts for post-mortem capture */
+            raw_history_update(&cy_capsense_context);
+#endif
+
+#if (0u != NOISE_METRICS_EN)
+            /* Measure the raw count noise at each scan frequency */
+            noise_metrics_update(&cy_capsense_context);
+#endif
+
+#if (0u != SIGNAL_STATS_EN)
+            /* Update the noise, signal, and drift statistics */
+            signal_stats_update(&cy_capsense_context);
+#endif
+
+            stage_start = PROFILER_MARK();
+            run_tuner();
+            PROFILER_RECORD(PROFILER_STAGE_TUNER, stage_start);
+            PROFILER_RECORD(PROFILER_STAGE_REPORT, report_start);
+
+#if (0u != TUNING_STORE_EN)
+            /* Save or erase the tuning profile, if requested */
+            tuning_store_process(&cy_capsense_context);
+#endif
+
+            PROFILER_RECORD(PROFILER_STAGE_CYCLE, cycle_start);
+            cycle_start = PROFILER_MARK();
+            PROFILER_REPORT();
+
+            /* Start the next scan cycle */
+            widget_id = 0u;
+            scan_start = PROFILER_MARK();
+            capsense_scan_done = false;
+            RTT_TUNER_UPDATE_BEGIN();
+            Cy_CapSense_ScanWidget(widget_id, &cy_capsense_context);
+        }
+    }
+#else
+#if (0u != SCAN_SCHEDULER_EN)
+    scan_scheduler_init();
+#endif
+
+    /* Start the first scan. The CAPSENSE interrupt writes the raw counts
+     * during the scan, so the tuner data is updated until it is processed.
+     */
+    scan_start = PROFILER_MARK();
+    cycle_start = scan_start;
+    RTT_TUNER_UPDATE_BEGIN();
+#if (0u != SCAN_SCHEDULER_EN)
+    scan_scheduler_scan(&cy_capsense_context);
+#else
     Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+#endif
+    first_scan = timestamp_get();
+
+#if (0u != FAST_START_EN)
+    /* Initialize RTT while the first scan runs */
+    initialize_rtt();
+#endif
+    DEFERRED_LOG3("Started, %u widgets, core clock %u Hz, first scan after %u cycles",
+                  CY_CAPSENSE_WIDGET_COUNT, SystemCoreClock, first_scan);
 
     for (;;)
     {
         if(CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
         {
-            /* Process all widgets */
+            PROFILER_RECORD(PROFILER_STAGE_SCAN, scan_start);
+            report_start = PROFILER_MARK();
+
+            /* Process the scanned widgets */
+            stage_start = PROFILER_MARK();
+#if (0u != SCAN_SCHEDULER_EN)
+            scan_scheduler_process(&cy_capsense_context);
+#else
             Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
+#endif
+            RTT_TUNER_UPDATE_END();
+            PROFILER_RECORD(PROFILER_STAGE_PROCESS, stage_start);
+
+#if (0u != SLIDER_FILTER_EN)
+            /* Filter the slider positions */
+            stage_start = PROFILER_MARK();
+            slider_filter_update(&cy_capsense_context);
+            PROFILER_RECORD(PROFILER_STAGE_FILTER, stage_start);
+#endif
+
+#if (0u != TOUCH_EVENTS_EN)
+            /* Report button and slider changes */
+            touch_events_update(&cy_capsense_context);
+#endif
+
+#if (0u != RAW_HISTORY_EN)
+            /* Record the counts for post-mortem capture */
+            raw_history_update(&cy_capsense_context);
+#endif
+
+#if (0u != NOISE_METRICS_EN)
+            /* Measure the raw count noise at each scan frequency */
+            noise_metrics_update(&cy_capsense_context);
+#endif
+
+#if (0u != SIGNAL_STATS_EN)
+            /* Update the noise, signal, and drift statistics */
+            signal_stats_update(&cy_capsense_context);
+#endif
 
             /* Establishes synchronized communication with the CAPSENSE Tuner tool */
-            Cy_CapSense_RunTuner(&cy_capsense_context);
+            stage_start = PROFILER_MARK();
+            run_tuner();
+            PROFILER_RECORD(PROFILER_STAGE_TUNER, stage_start);
+            PROFILER_RECORD(PROFILER_STAGE_REPORT, report_start);
+
+#if (0u != TUNING_STORE_EN)
+            /* Save or erase the tuning profile, if requested */
+            tuning_store_process(&cy_capsense_context);
+#endif
+
+            PROFILER_RECORD(PROFILER_STAGE_CYCLE, cycle_start);
+            cycle_start = PROFILER_MARK();
+            PROFILER_REPORT();
 
             /* Start the next scan */
+#if (0u != SCAN_SCHEDULER_EN)
+            scan_scheduler_wait();
+            scan_start = PROFILER_MARK();
+            RTT_TUNER_UPDATE_BEGIN();
+            scan_scheduler_scan(&cy_capsense_context);
+#else
+            scan_start = PROFILER_MARK();
+            RTT_TUNER_UPDATE_BEGIN();
             Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+#endif
 
         }
     }
+#endif
+}
+
+
+/*******************************************************************************
+ * Function Name: initialize_rtt
+ ********************************************************************************
+ * Summary:
+ *  Initializes the RTT control block and configures the up and down buffers
+ *  of all RTT channels compiled in. With FAST_START_EN, the log records
+ *  written before are dropped and counted.
+ *
+ *******************************************************************************/
+static void initialize_rtt(void)
+{
+    /* Initializes the RTT Control Block */
+    SEGGER_RTT_Init();
+#if defined(RTT_CB_ADDRESS)
+    /* The linker places the control block at the published address */
+    CY_ASSERT((uint32_t)(uintptr_t)&_SEGGER_RTT == (uint32_t)(RTT_CB_ADDRESS));
+#endif
+    /* Configure the up and down buffers of the tuner channel */
+    rtt_tuner_init();
+    /* Configure the profiler channel, if compiled in */
+    PROFILER_INIT();
+    /* Configure the log channel, if compiled in */
+    DEFERRED_LOG_INIT();
+#if (0u != TOUCH_EVENTS_EN)
+    /* Configure the touch event channel */
+    touch_events_init();
+#endif
+#if (0u != RAW_HISTORY_EN)
+    /* Configure the raw count history channel */
+    raw_history_init();
+#endif
+#if (0u != NOISE_METRICS_EN)
+    /* Configure the noise metrics channel */
+    noise_metrics_init();
+#endif
+#if (0u != SIGNAL_STATS_EN)
+    /* Configure the signal statistics channel */
+    signal_stats_init();
+#endif
+#if (0u != SCAN_LOW_POWER_EN)
+    /* Configure the low-power status channel */
+    scan_scheduler_status_init();
+#endif
+
+#if (0u != FAST_START_EN)
+    /* Offer one frame, a host that reads it enables the tuner */
+    rtt_tuner_send(NULL);
+#endif
 }
 
 
@@ -168,6 +427,10 @@ int main(void)
 static void initialize_capsense(void)
 {
     cy_capsense_status_t status = CY_CAPSENSE_STATUS_SUCCESS;
+#if (0u != TUNING_STORE_EN)
+    uint32_t start = timestamp_get();
+    bool restored = false;
+#endif
 
     /* CAPSENSE interrupt configuration */
     static const cy_stc_sysint_t capsense_interrupt_config =
@@ -179,6 +442,14 @@ static void initialize_capsense(void)
     /* Capture the CSD HW block and initialize it to the default state. */
     status = Cy_CapSense_Init(&cy_capsense_context);
 
+#if (0u != TUNING_STORE_EN)
+    if (CY_CAPSENSE_STATUS_SUCCESS == status)
+    {
+        /* Replace the design defaults by the saved tuning profile */
+        restored = tuning_store_restore(&cy_capsense_context);
+    }
+#endif
+
     if (CY_CAPSENSE_STATUS_SUCCESS == status)
     {
         /* Initialize CAPSENSE interrupt */
@@ -190,12 +461,36 @@ static void initialize_capsense(void)
         status = Cy_CapSense_Enable(&cy_capsense_context);
     }
 
+#if (0u != TUNING_STORE_EN) && (0u != TUNING_STORE_CALIBRATE)
+    if ((CY_CAPSENSE_STATUS_SUCCESS == status) && !restored)
+    {
+        /* The TUNING_STORE=1 designs do not calibrate in Cy_CapSense_Enable(),
+         * so that the restored IDAC values are kept. Without a profile, the
+         * IDACs are calibrated here instead. */
+        status = Cy_CapSense_CalibrateAllWidgets(&cy_capsense_context);
+    }
+#endif
+
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN)
+    if (CY_CAPSENSE_STATUS_SUCCESS == status)
+    {
+        /* Wake the main loop at the end of each widget scan */
+        status = Cy_CapSense_RegisterCallback(CY_CAPSENSE_END_OF_SCAN_E,
+                                              capsense_end_of_scan, &cy_capsense_context);
+    }
+#endif
+
     if(status != CY_CAPSENSE_STATUS_SUCCESS)
     {
         /* This status could fail before tuning the sensors correctly.
          * Ensure that this function passes after the CapSense sensors are tuned
          * as per procedure given in the README.md file */
+        DEFERRED_LOG1("CAPSENSE initialization failed, status 0x%08X", status);
     }
+
+#if (0u != TUNING_STORE_EN)
+    DEFERRED_LOG2("CAPSENSE ready after %u cycles, tuning profile restored %u", timestamp_get() - start, restored);
+#endif
 }
 
 
@@ -208,81 +503,107 @@ static void initialize_capsense(void)
  *******************************************************************************/
 static void capsense_isr(void)
 {
+    uint32_t isr_start = PROFILER_MARK();
+
     Cy_CapSense_InterruptHandler(CYBSP_CSD_HW, &cy_capsense_context);
+
+    PROFILER_RECORD(PROFILER_STAGE_ISR, isr_start);
 }
 
 
+#if (0u != CAPSENSE_SCAN_PIPELINE_EN)
 /*******************************************************************************
- * Function Name: initialize_capsense_tuner
+ * Function Name: capsense_end_of_scan
  ********************************************************************************
  * Summary:
- *  Initializes interface between Tuner GUI and PSoC 4 MCU.
+ *  End-of-scan callback, called by the middleware from capsense_isr when the
+ *  scan of the current widget is complete.
+ *
+ * Parameters:
+ *  ptrActiveScan: pointer to the active sensor structure (unused)
  *
  *******************************************************************************/
-static void initialize_capsense_tuner(void)
+static void capsense_end_of_scan(cy_stc_active_scan_sns_t * ptrActiveScan)
 {
-    cy_capsense_context.ptrInternalContext->ptrTunerSendCallback    = rtt_tuner_send;
-    cy_capsense_context.ptrInternalContext->ptrTunerReceiveCallback = rtt_tuner_receive;
+    (void)ptrActiveScan;
+
+    capsense_scan_done = true;
 }
 
 
 /*******************************************************************************
- * Function Name: rtt_tuner_send
+ * Function Name: capsense_wait_for_scan
  ********************************************************************************
  * Summary:
- *  This function sends the CAPSENSE data to Tuner through RTT
+ *  Puts the CPU to sleep until the end-of-scan callback has run. Interrupts are
+ *  masked around the flag check: a pending interrupt still wakes the CPU from
+ *  WFI, so an end of scan right after the check is not missed.
  *
  *******************************************************************************/
-static void rtt_tuner_send(void * context)
+static void capsense_wait_for_scan(void)
 {
-    (void)context;
+    __disable_irq();
+    while (!capsense_scan_done)
+    {
+        __WFI();
+
+        /* Let the pending interrupt run, then check again */
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+#endif
 
-    SEGGER_RTT_LOCK();
-    SEGGER_RTT_BUFFER_UP *buffer = _SEGGER_RTT.aUp + RTT_TUNER_CHANNEL;
-    buffer->RdOff = 0u;
-    buffer->WrOff = sizeof(tuner_up_buf);
 
-    memcpy(tuner_up_buf.tuner_data, &cy_capsense_tuner, sizeof(cy_capsense_tuner));
-    SEGGER_RTT_UNLOCK();
+/*******************************************************************************
+ * Function Name: initialize_capsense_tuner
+ ********************************************************************************
+ * Summary:
+ *  Initializes interface between Tuner GUI and PSoC 4 MCU.
+ *
+ *******************************************************************************/
+static void initialize_capsense_tuner(void)
+{
+    cy_capsense_context.ptrInternalContext->ptrTunerSendCallback    = rtt_tuner_send;
+    cy_capsense_context.ptrInternalContext->ptrTunerReceiveCallback = rtt_tuner_receive;
 }
 
 
 /*******************************************************************************
- * Function Name: rtt_tuner_receive
+ * Function Name: run_tuner
  ********************************************************************************
  * Summary:
- *  RTT receives the Tuner command
+ *  Establishes synchronized communication with the CAPSENSE Tuner tool. The
+ *  middleware takes one command per call, so it runs again while more
+ *  commands are queued. With FAST_START_EN, nothing is done until a host
+ *  has connected, with SCAN_LOW_POWER_EN nothing while idle.
  *
  *******************************************************************************/
-static void rtt_tuner_receive(uint8_t ** packet, uint8_t ** tuner_packet, void * context)
+static void run_tuner(void)
 {
-    uint32_t i;
-    static uint32_t data_index = 0u;
-    static uint8_t command_packet[16u] = {0u};
-    while(0 != SEGGER_RTT_HasData(RTT_TUNER_CHANNEL))
+    uint32_t commands = 0u;
+
+#if (0u != FAST_START_EN)
+    if (!rtt_tuner_host_connected())
     {
-        uint8_t byte;
-        SEGGER_RTT_Read(RTT_TUNER_CHANNEL, &byte, 1);
-        command_packet[data_index++] = byte;
-        if (CY_CAPSENSE_COMMAND_PACKET_SIZE == data_index)
-        {
-            if (CY_CAPSENSE_COMMAND_OK == Cy_CapSense_CheckTunerCmdIntegrity(&command_packet[0u]))
-            {
-                data_index = 0u;
-                *tuner_packet = (uint8_t *)&cy_capsense_tuner;
-                *packet = &command_packet[0u];
-                break;
-            }
-            else
-            {
-                data_index--;
-                for(i = 0u; i < (CY_CAPSENSE_COMMAND_PACKET_SIZE - 1u); i++)
-                {
-                    command_packet[i] = command_packet[i + 1u];
-                }
-            }
-        }
+        return;
     }
+#endif
+
+#if (0u != SCAN_LOW_POWER_EN)
+    /* Paused in low-power idle, a command from the host ends the idle state */
+    if (scan_scheduler_idle())
+    {
+        return;
+    }
+#endif
+
+    do
+    {
+        Cy_CapSense_RunTuner(&cy_capsense_context);
+        commands++;
+    } while ((commands < RTT_TUNER_MAX_COMMANDS) && rtt_tuner_command_pending());
 }
 
 
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * File Name: noise_metrics.c
+ *
+ * Description: This file contains the noise metrics. After each scan cycle,
+ * the raw count of every sensor at every scan frequency is added to a window
+ * with constant work per sample. At the end of a window, the peak-to-peak
+ * noise and the variance are written as one record to an RTT up-buffer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "noise_metrics.h"
+
+#if (0u != NOISE_METRICS_EN)
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* The deviations of a window below 2^16 each sum up to less than 2^31 */
+#if ((NOISE_METRICS_WINDOW & (NOISE_METRICS_WINDOW - 1u)) != 0u) || (NOISE_METRICS_WINDOW < 2u) || (NOISE_METRICS_WINDOW > 16384u)
+#error "NOISE_METRICS_WINDOW must be a power of two from 2 to 16384"
+#endif
+
+/* The sensor contexts of all widgets are one array, and with multi-frequency
+ * scan the contexts of the second and third frequency follow those of the
+ * first one, CY_CAPSENSE_SENSOR_COUNT apart. The record entries have the same
+ * order.
+ */
+#define NOISE_METRICS_SAMPLES           (NOISE_METRICS_FREQ_NUM * CY_CAPSENSE_SENSOR_COUNT)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Running sums of one sensor at one scan frequency. The deviations from the
+ * first count of the window keep the sum of squares small.
+ */
+typedef struct
+{
+    uint16_t first;
+    uint16_t min;
+    uint16_t max;
+    int32_t  sum;
+    uint64_t sum_squares;
+} noise_metrics_acc_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+RTT_CHANNEL_BUFFER(noise_metrics_up_buf, NOISE_METRICS_BUF_RECORDS * sizeof(noise_metrics_record_t));
+
+static noise_metrics_acc_t noise_metrics_acc[NOISE_METRICS_SAMPLES];
+static noise_metrics_record_t noise_metrics_record;
+static uint32_t noise_metrics_count = 0u;
+static uint16_t noise_metrics_sequence = 0u;
+
+
+/*******************************************************************************
+ * Function Name: noise_metrics_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the noise metrics up-buffer. SEGGER_RTT_Init() must have been
+ *  called before.
+ *
+ *******************************************************************************/
+void noise_metrics_init(void)
+{
+    RTT_CHANNEL_CONFIG_UP(NOISE_METRICS_RTT_CHANNEL, "noise", noise_metrics_up_buf, RTT_CHANNEL_RECORD_FLAGS);
+}
+
+
+/*******************************************************************************
+ * Function Name: noise_metrics_variance
+ ********************************************************************************
+ * Summary:
+ *  Calculates the variance of a window from its running sums. The window is
+ *  a power of two, so the divisions compile to shifts.
+ *
+ * Parameters:
+ *  acc: running sums of a full window
+ *
+ * Return:
+ *  Variance, saturated at 0xFFFF
+ *
+ *******************************************************************************/
+static uint16_t noise_metrics_variance(const noise_metrics_acc_t * acc)
+{
+    uint64_t square_of_sum;
+    uint64_t variance;
+
+    /* n * var = sum(d^2) - sum(d)^2 / n, n is a power of two */
+    square_of_sum = (uint64_t)((int64_t)acc->sum * acc->sum) / NOISE_METRICS_WINDOW;
+    variance = (acc->sum_squares - square_of_sum) / NOISE_METRICS_WINDOW;
+
+    return (variance > 0xFFFFu) ? 0xFFFFu : (uint16_t)variance;
+}
+
+
+/*******************************************************************************
+ * Function Name: noise_metrics_update
+ ********************************************************************************
+ * Summary:
+ *  Adds the raw count of every sensor at every scan frequency to the current
+ *  window. Call once per scan cycle after all widgets are processed. At the
+ *  end of a window, writes the record and starts the next window. The record
+ *  is dropped if the up-buffer is full, which the host detects from the
+ *  sequence number.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void noise_metrics_update(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_sensor_context_t * sensor = context->ptrWdConfig[0u].ptrSnsContext;
+    noise_metrics_acc_t * acc = noise_metrics_acc;
+    noise_metrics_entry_t * entry;
+    uint16_t raw;
+    int32_t deviation;
+    uint32_t magnitude;
+    uint32_t i;
+
+    for (i = 0u; i < NOISE_METRICS_SAMPLES; i++)
+    {
+        raw = sensor[i].raw;
+
+        if (0u == noise_metrics_count)
+        {
+            acc->first = raw;
+            acc->min = raw;
+            acc->max = raw;
+            acc->sum = 0;
+            acc->sum_squares = 0u;
+        }
+        else
+        {
+            if (raw < acc->min)
+            {
+                acc->min = raw;
+            }
+            if (raw > acc->max)
+            {
+                acc->max = raw;
+            }
+
+            /* |deviation| < 2^16, so its square fits 32 bits unsigned */
+            deviation = (int32_t)raw - (int32_t)acc->first;
+            magnitude = (uint32_t)((deviation < 0) ? -deviation : deviation);
+            acc->sum += deviation;
+            acc->sum_squares += magnitude * magnitude;
+        }
+        acc++;
+    }
+
+    noise_metrics_count++;
+    if (NOISE_METRICS_WINDOW == noise_metrics_count)
+    {
+        noise_metrics_count = 0u;
+
+        noise_metrics_record.sequence = noise_metrics_sequence++;
+        noise_metrics_record.sensors = (uint8_t)CY_CAPSENSE_SENSOR_COUNT;
+        noise_metrics_record.frequencies = (uint8_t)NOISE_METRICS_FREQ_NUM;
+        noise_metrics_record.window = (uint16_t)NOISE_METRICS_WINDOW;
+        noise_metrics_record.reserved = 0u;
+        entry = &noise_metrics_record.entry[0u][0u];
+        for (i = 0u; i < NOISE_METRICS_SAMPLES; i++)
+        {
+            entry[i].peak_to_peak = noise_metrics_acc[i].max - noise_metrics_acc[i].min;
+            entry[i].variance = noise_metrics_variance(&noise_metrics_acc[i]);
+        }
+
+        RTT_CHANNEL_WRITE(NOISE_METRICS_RTT_CHANNEL, &noise_metrics_record, sizeof(noise_metrics_record));
+    }
+}
+#endif /* NOISE_METRICS_EN */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * File Name: noise_metrics.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the noise metrics, which measure the raw count noise of every sensor at
+ * each scan frequency on target and report it over RTT.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef NOISE_METRICS_H
+#define NOISE_METRICS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Measure the raw count noise of every sensor */
+#ifndef NOISE_METRICS_EN
+#define NOISE_METRICS_EN                (0u)
+#endif
+
+/* Number of scans per measurement window, a power of two up to 16384 */
+#ifndef NOISE_METRICS_WINDOW
+#define NOISE_METRICS_WINDOW            (64u)
+#endif
+
+/* Number of records the up-buffer holds */
+#ifndef NOISE_METRICS_BUF_RECORDS
+#define NOISE_METRICS_BUF_RECORDS       (2u)
+#endif
+
+/* Scan frequencies per sensor, generated from the Multi-frequency scan
+ * setting of the CAPSENSE Configurator
+ */
+#if (0u != CY_CAPSENSE_MULTI_FREQUENCY_SCAN_EN)
+#define NOISE_METRICS_FREQ_NUM          (3u)
+#else
+#define NOISE_METRICS_FREQ_NUM          (1u)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Noise of one sensor at one scan frequency over a window */
+typedef struct
+{
+    uint16_t peak_to_peak;  /* Largest minus smallest raw count */
+    uint16_t variance;      /* Raw count variance, saturated at 0xFFFF */
+} noise_metrics_entry_t;
+
+/* Record of one window, all fields are little-endian */
+typedef struct
+{
+    uint16_t sequence;      /* Incremented per window */
+    uint8_t  sensors;       /* CY_CAPSENSE_SENSOR_COUNT */
+    uint8_t  frequencies;   /* NOISE_METRICS_FREQ_NUM */
+    uint16_t window;        /* NOISE_METRICS_WINDOW */
+    uint16_t reserved;
+    noise_metrics_entry_t entry[NOISE_METRICS_FREQ_NUM][CY_CAPSENSE_SENSOR_COUNT];
+} noise_metrics_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != NOISE_METRICS_EN)
+void noise_metrics_init(void);
+void noise_metrics_update(const cy_stc_capsense_context_t * context);
+#endif
+
+#endif /* NOISE_METRICS_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,241 @@
+/******************************************************************************
+ * File Name: profiler.c
+ *
+ * Description: This file implements the per-stage execution time
+ * profiler. Durations in CPU cycles are accumulated into min/max/average and
+ * a logarithmic histogram per stage, and published as binary records on
+ * PROFILER_RTT_CHANNEL every PROFILER_REPORT_INTERVAL scan cycles.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "profiler.h"
+
+#if (0u != PROFILER_EN)
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#if (0u != PROFILER_BENCHMARK_EN) && (0u == PROFILER_BENCHMARK_CYCLES)
+#error "PROFILER_BENCHMARK_CYCLES must not be 0"
+#endif
+
+#define PROFILER_HEADER0                (0x0Du)
+#define PROFILER_HEADER1                (0x50u)
+
+/* Room for two complete reports */
+#define PROFILER_UP_BUF_SIZE            (2u * PROFILER_STAGE_COUNT * sizeof(profiler_record_t))
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t hist[PROFILER_HIST_BINS];
+} profiler_stats_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static profiler_stats_t profiler_stats[PROFILER_STAGE_COUNT];
+static uint32_t profiler_cycles = 0u;
+RTT_CHANNEL_BUFFER(profiler_up_buf, PROFILER_UP_BUF_SIZE);
+
+
+/*******************************************************************************
+ * Function Name: profiler_reset_stats
+ ********************************************************************************
+ * Summary:
+ *  Clears the statistics of one stage.
+ *
+ *******************************************************************************/
+static void profiler_reset_stats(profiler_stats_t * stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->min = UINT32_MAX;
+}
+
+
+/*******************************************************************************
+ * Function Name: profiler_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the profiler up-buffer and clears all statistics.
+ *  SEGGER_RTT_Init() must have been called before.
+ *
+ *******************************************************************************/
+void profiler_init(void)
+{
+    uint32_t stage;
+
+    for (stage = 0u; stage < PROFILER_STAGE_COUNT; stage++)
+    {
+        profiler_reset_stats(&profiler_stats[stage]);
+    }
+
+    RTT_CHANNEL_CONFIG_UP(PROFILER_RTT_CHANNEL, "profiler", profiler_up_buf, RTT_CHANNEL_RECORD_FLAGS);
+}
+
+
+/*******************************************************************************
+ * Function Name: profiler_record
+ ********************************************************************************
+ * Summary:
+ *  Adds one duration to the statistics of a stage. Each stage must only be
+ *  recorded from one context; stages recorded in interrupts are read by
+ *  profiler_report() inside a critical section.
+ *
+ * Parameters:
+ *  stage: stage the duration belongs to
+ *  cycles: duration in CPU cycles
+ *
+ *******************************************************************************/
+void profiler_record(profiler_stage_t stage, uint32_t cycles)
+{
+    profiler_stats_t * stats = &profiler_stats[stage];
+    uint32_t bin = 0u;
+    uint32_t value = cycles >> PROFILER_HIST_SHIFT;
+
+    /* No CLZ on Cortex-M0+, the loop runs at most PROFILER_HIST_BINS times */
+    while ((0u != value) && (bin < (PROFILER_HIST_BINS - 1u)))
+    {
+        value >>= 1u;
+        bin++;
+    }
+
+    if (UINT16_MAX != stats->hist[bin])
+    {
+        stats->hist[bin]++;
+    }
+    if (cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+    stats->sum += cycles;
+    stats->count++;
+}
+
+
+/*******************************************************************************
+ * Function Name: profiler_report
+ ********************************************************************************
+ * Summary:
+ *  Called once per scan cycle. Every PROFILER_REPORT_INTERVAL cycles, writes
+ *  one record per stage to the profiler up-buffer and restarts the statistics.
+ *  Records that do not fit in the up-buffer are dropped. With
+ *  PROFILER_BENCHMARK_EN, writes a single report after the benchmark cycles
+ *  and does not return.
+ *
+ *******************************************************************************/
+void profiler_report(void)
+{
+    profiler_record_t record;
+    profiler_stats_t stats;
+    uint32_t interrupt_state;
+    uint32_t stage;
+
+#if (0u != PROFILER_BENCHMARK_EN)
+    if (++profiler_cycles == PROFILER_BENCHMARK_WARMUP)
+    {
+        /* Drop the start-up cycles, which include the calibration */
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        for (stage = 0u; stage < PROFILER_STAGE_COUNT; stage++)
+        {
+            profiler_reset_stats(&profiler_stats[stage]);
+        }
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+    }
+    if (profiler_cycles < (PROFILER_BENCHMARK_WARMUP + PROFILER_BENCHMARK_CYCLES))
+    {
+        return;
+    }
+#else
+    if (++profiler_cycles < PROFILER_REPORT_INTERVAL)
+    {
+        return;
+    }
+    profiler_cycles = 0u;
+#endif
+
+    record.header[0u] = PROFILER_HEADER0;
+    record.header[1u] = PROFILER_HEADER1;
+    record.bins = (uint8_t)PROFILER_HIST_BINS;
+    record.core_clock_hz = SystemCoreClock;
+
+    for (stage = 0u; stage < PROFILER_STAGE_COUNT; stage++)
+    {
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        stats = profiler_stats[stage];
+        profiler_reset_stats(&profiler_stats[stage]);
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+        record.stage = (uint8_t)stage;
+        record.count = stats.count;
+        record.min = (0u != stats.count) ? stats.min : 0u;
+        record.max = stats.max;
+        record.avg = (0u != stats.count) ? (uint32_t)(stats.sum / stats.count) : 0u;
+        memcpy(record.hist, stats.hist, sizeof(record.hist));
+
+        RTT_CHANNEL_WRITE(PROFILER_RTT_CHANNEL, &record, sizeof(record));
+    }
+
+#if (0u != PROFILER_BENCHMARK_EN)
+    /* Benchmark complete: no further scans, the report stays in the up-buffer
+     * until the host reads it
+     */
+    for (;;)
+    {
+        __WFI();
+    }
+#endif
+}
+#endif /* PROFILER_EN */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * File Name: profiler.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the per-stage execution time profiler, which publishes cycle count
+ * statistics on a dedicated RTT up-buffer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "timestamp.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Compile in the profiler */
+#ifndef PROFILER_EN
+#define PROFILER_EN                     (0u)
+#endif
+
+/* Number of scan cycles between two reports */
+#ifndef PROFILER_REPORT_INTERVAL
+#define PROFILER_REPORT_INTERVAL        (100u)
+#endif
+
+/* Benchmark: the statistics restart after PROFILER_BENCHMARK_WARMUP scan
+ * cycles, and one report is written after PROFILER_BENCHMARK_CYCLES more,
+ * after which the firmware stops
+ */
+#ifndef PROFILER_BENCHMARK_EN
+#define PROFILER_BENCHMARK_EN           (0u)
+#endif
+
+#ifndef PROFILER_BENCHMARK_CYCLES
+#define PROFILER_BENCHMARK_CYCLES       (1000u)
+#endif
+
+#ifndef PROFILER_BENCHMARK_WARMUP
+#define PROFILER_BENCHMARK_WARMUP       (16u)
+#endif
+
+/* Histogram bin k counts durations in [2^(SHIFT+k-1), 2^(SHIFT+k)) cycles,
+ * bin 0 everything below 2^SHIFT and the last bin everything above.
+ */
+#define PROFILER_HIST_BINS              (16u)
+#define PROFILER_HIST_SHIFT             (6u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    PROFILER_STAGE_SCAN,        /* Hardware scan of all widgets */
+    PROFILER_STAGE_PROCESS,     /* Processing of all widgets */
+    PROFILER_STAGE_TUNER,       /* Cy_CapSense_RunTuner and the RTT transport */
+    PROFILER_STAGE_CYCLE,       /* Period between two completed scan cycles */
+    PROFILER_STAGE_ISR,         /* Execution time of capsense_isr */
+    PROFILER_STAGE_IRQ_LATENCY, /* Interrupt entry latency, sampled at SysTick wrap */
+    PROFILER_STAGE_FILTER,      /* slider_filter_update, with SLIDER_FILTER_EN */
+    PROFILER_STAGE_REPORT,      /* End of the scan to the end of the tuner stage */
+    PROFILER_STAGE_COUNT
+} profiler_stage_t;
+
+/* Report record, one per stage, all fields are little-endian */
+typedef struct
+{
+    uint8_t  header[2];
+    uint8_t  stage;
+    uint8_t  bins;
+    uint32_t core_clock_hz;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t avg;
+    uint16_t hist[PROFILER_HIST_BINS];
+} profiler_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != PROFILER_EN)
+void profiler_init(void);
+void profiler_record(profiler_stage_t stage, uint32_t cycles);
+void profiler_report(void);
+
+#define PROFILER_INIT()                 profiler_init()
+#define PROFILER_MARK()                 timestamp_get()
+#define PROFILER_RECORD(stage, start)   profiler_record((stage), timestamp_get() - (start))
+#define PROFILER_REPORT()               profiler_report()
+#else
+#define PROFILER_INIT()
+#define PROFILER_MARK()                 (0u)
+#define PROFILER_RECORD(stage, start)   ((void)(start))
+#define PROFILER_REPORT()
+#endif
+
+#endif /* PROFILER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,271 @@
+/******************************************************************************
+ * File Name: raw_history.c
+ *
+ * Description: This file contains the raw count history. After each scan
+ * cycle, the raw and difference counts of all sensors are written to a ring
+ * in RAM. On a trigger, the ring is frozen and published on an RTT up-buffer,
+ * so the host reads the complete history in one transfer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "raw_history.h"
+
+#if (0u != RAW_HISTORY_EN)
+#include <string.h>
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* One slot more than the depth, so a full history never fills the up-buffer */
+#define RAW_HISTORY_SLOTS               (RAW_HISTORY_DEPTH + 1u)
+
+
+#if (RAW_HISTORY_POST_TRIGGER >= RAW_HISTORY_DEPTH)
+#error "RAW_HISTORY_POST_TRIGGER must be smaller than RAW_HISTORY_DEPTH"
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    RAW_HISTORY_RECORDING,      /* Ring is filled after each scan */
+    RAW_HISTORY_TRIGGERED,      /* Recording the scans after the trigger */
+    RAW_HISTORY_PUBLISHED       /* Ring is frozen until the host has read it */
+} raw_history_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+/* The ring is the up-buffer itself. While recording, RdOff equals WrOff, so
+ * the host sees no data and the ring costs no link bandwidth.
+ */
+CY_ALIGN(RTT_BUFFER_ALIGNMENT) static raw_history_record_t raw_history_ring[RAW_HISTORY_SLOTS];
+static uint8_t raw_history_down_buf[4];
+
+static raw_history_state_t raw_history_state;
+static uint32_t raw_history_next;       /* Slot written by the next scan */
+static uint32_t raw_history_count;      /* Valid records in the ring */
+static uint32_t raw_history_post;       /* Scans left to record after the trigger */
+static uint16_t raw_history_sequence;
+static bool raw_history_trigger_pending;
+static bool raw_history_active;
+
+
+/*******************************************************************************
+ * Function Name: raw_history_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the history up-buffer and the down-buffer for dump requests.
+ *  SEGGER_RTT_Init() must have been called before.
+ *
+ *******************************************************************************/
+void raw_history_init(void)
+{
+    RTT_CHANNEL_CONFIG_UP(RAW_HISTORY_RTT_CHANNEL, "history", raw_history_ring, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    RTT_CHANNEL_CONFIG_DOWN(RAW_HISTORY_DOWN_CHANNEL, "history", raw_history_down_buf, SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+    raw_history_state = RAW_HISTORY_RECORDING;
+}
+
+
+/*******************************************************************************
+ * Function Name: raw_history_trigger
+ ********************************************************************************
+ * Summary:
+ *  Freezes the history after RAW_HISTORY_POST_TRIGGER more scans. Call from
+ *  the application when it detects a condition worth capturing. Ignored while
+ *  a previous history waits for the host.
+ *
+ *******************************************************************************/
+void raw_history_trigger(void)
+{
+    raw_history_trigger_pending = true;
+}
+
+
+/*******************************************************************************
+ * Function Name: raw_history_reverse
+ ********************************************************************************
+ * Summary:
+ *  Reverses the order of the bytes in [first, last).
+ *
+ *******************************************************************************/
+static void raw_history_reverse(uint8_t * first, uint8_t * last)
+{
+    uint8_t byte;
+
+    while (first < --last)
+    {
+        byte = *first;
+        *first++ = *last;
+        *last = byte;
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: raw_history_publish
+ ********************************************************************************
+ * Summary:
+ *  Rotates the ring so the oldest record starts at the current write offset
+ *  of the up-buffer, and then advances the write offset over all records. The
+ *  host thus reads the history in order, oldest record first, with a single
+ *  RTT read, and the read offset it writes back marks the dump as complete.
+ *
+ *******************************************************************************/
+static void raw_history_publish(void)
+{
+    SEGGER_RTT_BUFFER_UP * up = &_SEGGER_RTT.aUp[RAW_HISTORY_RTT_CHANNEL];
+    uint8_t * ring = (uint8_t *)raw_history_ring;
+    uint32_t base = up->WrOff / sizeof(raw_history_record_t);
+    uint32_t oldest = (raw_history_next + RAW_HISTORY_SLOTS - raw_history_count) % RAW_HISTORY_SLOTS;
+    uint32_t shift = ((oldest + RAW_HISTORY_SLOTS - base) % RAW_HISTORY_SLOTS) * sizeof(raw_history_record_t);
+    uint32_t wr_off;
+
+    /* Rotate left by shift bytes, records keep their byte order */
+    if (0u != shift)
+    {
+        raw_history_reverse(ring, ring + shift);
+        raw_history_reverse(ring + shift, ring + sizeof(raw_history_ring));
+        raw_history_reverse(ring, ring + sizeof(raw_history_ring));
+    }
+
+    wr_off = ((base + raw_history_count) % RAW_HISTORY_SLOTS) * sizeof(raw_history_record_t);
+
+    /* The records must be in memory before the host can see them */
+    __DSB();
+    up->WrOff = wr_off;
+
+    raw_history_next = (base + raw_history_count) % RAW_HISTORY_SLOTS;
+    raw_history_count = 0u;
+    raw_history_state = RAW_HISTORY_PUBLISHED;
+}
+
+
+/*******************************************************************************
+ * Function Name: raw_history_update
+ ********************************************************************************
+ * Summary:
+ *  Records the raw and difference counts of all sensors. Call once per scan
+ *  cycle after all widgets are processed. A dump request from the host
+ *  freezes the ring at once, a trigger after the post-trigger scans. Recording
+ *  restarts when the host has read the published history.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void raw_history_update(const cy_stc_capsense_context_t * context)
+{
+    raw_history_record_t * record;
+    uint8_t request;
+    bool active;
+    uint32_t i;
+
+    active = (0u != Cy_CapSense_IsAnyWidgetActive(context));
+#if (0u != RAW_HISTORY_TRIGGER_ON_TOUCH)
+    if (active && !raw_history_active)
+    {
+        raw_history_trigger_pending = true;
+    }
+#endif
+    raw_history_active = active;
+
+    if (RAW_HISTORY_PUBLISHED == raw_history_state)
+    {
+        if (0u != SEGGER_RTT_HasDataUp(RAW_HISTORY_RTT_CHANNEL))
+        {
+            return;
+        }
+
+        raw_history_state = RAW_HISTORY_RECORDING;
+        raw_history_trigger_pending = false;
+    }
+
+    record = &raw_history_ring[raw_history_next];
+    record->sequence = raw_history_sequence++;
+    record->sensors = (uint8_t)CY_CAPSENSE_SENSOR_COUNT;
+    record->flags = 0u;
+    for (i = 0u; i < CY_CAPSENSE_SENSOR_COUNT; i++)
+    {
+        record->sample[i].raw = cy_capsense_tuner.sensorContext[i].raw;
+        record->sample[i].diff = cy_capsense_tuner.sensorContext[i].diff;
+    }
+
+    raw_history_next = (raw_history_next + 1u) % RAW_HISTORY_SLOTS;
+    if (raw_history_count < RAW_HISTORY_DEPTH)
+    {
+        raw_history_count++;
+    }
+
+    if ((RAW_HISTORY_RECORDING == raw_history_state) && raw_history_trigger_pending)
+    {
+        record->flags = RAW_HISTORY_FLAG_TRIGGER;
+        raw_history_trigger_pending = false;
+        raw_history_post = RAW_HISTORY_POST_TRIGGER;
+        raw_history_state = RAW_HISTORY_TRIGGERED;
+    }
+    else if (RAW_HISTORY_TRIGGERED == raw_history_state)
+    {
+        raw_history_post--;
+    }
+    else
+    {
+        /* Recording */
+    }
+
+    /* Any byte on the down-buffer requests a dump of the history so far */
+    if (0u != SEGGER_RTT_Read(RAW_HISTORY_DOWN_CHANNEL, &request, sizeof(request)))
+    {
+        raw_history_post = 0u;
+        raw_history_state = RAW_HISTORY_TRIGGERED;
+    }
+
+    if ((RAW_HISTORY_TRIGGERED == raw_history_state) && (0u == raw_history_post))
+    {
+        raw_history_publish();
+    }
+}
+#endif /* RAW_HISTORY_EN */
+
+
+/* [] END OF FILE */
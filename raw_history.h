@@ -0,0 +1,111 @@
+/******************************************************************************
+ * File Name: raw_history.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the raw count history, which keeps the raw and difference counts of the
+ * last scans in RAM for post-mortem capture over RTT.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef RAW_HISTORY_H
+#define RAW_HISTORY_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Keep a history of the raw and difference counts of the last scans */
+#ifndef RAW_HISTORY_EN
+#define RAW_HISTORY_EN                  (0u)
+#endif
+
+/* Number of scans the history holds */
+#ifndef RAW_HISTORY_DEPTH
+#define RAW_HISTORY_DEPTH               (32u)
+#endif
+
+/* Freeze the history when a widget becomes active, so the scans around the
+ * first touch are kept until the host reads them
+ */
+#ifndef RAW_HISTORY_TRIGGER_ON_TOUCH
+#define RAW_HISTORY_TRIGGER_ON_TOUCH    (1u)
+#endif
+
+/* Number of scans recorded after the trigger scan */
+#ifndef RAW_HISTORY_POST_TRIGGER
+#define RAW_HISTORY_POST_TRIGGER        (8u)
+#endif
+
+#define RAW_HISTORY_FLAG_TRIGGER        (0x01u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Counts of one sensor */
+typedef struct
+{
+    uint16_t raw;
+    uint16_t diff;
+} raw_history_sample_t;
+
+/* History record of one scan, all fields are little-endian */
+typedef struct
+{
+    uint16_t sequence;      /* Incremented per recorded scan */
+    uint8_t  sensors;       /* CY_CAPSENSE_SENSOR_COUNT */
+    uint8_t  flags;         /* RAW_HISTORY_FLAG_TRIGGER on the trigger scan */
+    raw_history_sample_t sample[CY_CAPSENSE_SENSOR_COUNT];
+} raw_history_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != RAW_HISTORY_EN)
+void raw_history_init(void);
+void raw_history_update(const cy_stc_capsense_context_t * context);
+void raw_history_trigger(void);
+#endif
+
+#endif /* RAW_HISTORY_H */
+
+
+/* [] END OF FILE */
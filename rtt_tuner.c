@@ -0,0 +1,1278 @@
+/******************************************************************************
+ * File Name: rtt_tuner.c
+ *
+ * Description: This file implements the RTT transport used by the
+ * CAPSENSE Tuner: tuner data frames on the up-buffer and command packets on
+ * the down-buffer of RTT_TUNER_CHANNEL.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "rtt_tuner.h"
+#include "timestamp.h"
+#include "tuning_store.h"
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define RTT_TX_HEADER0      0x0Du
+#define RTT_TX_HEADER1      0x0Au
+
+#define RTT_TX_TAIL0        0x00u
+#define RTT_TX_TAIL1        0xFFu
+#define RTT_TX_TAIL2        0xFFu
+#define RTT_TX_TAIL_SIZE    (3u)
+
+/* Command packets from the Tuner use the same header */
+#define RTT_RX_HEADER0      0x0Du
+#define RTT_RX_HEADER1      0x0Au
+
+#if (0u != RTT_TUNER_BATCH_EN)
+/* Batch of writes: header, write count, reserved byte, {16-bit offset, size,
+ * data} per write, CRC-16 of all bytes before it, tail
+ */
+#define RTT_RX_BATCH_HEADER1        0x0Bu
+#define RTT_RX_BATCH_HDR_SIZE       (4u)
+#define RTT_RX_BATCH_WRITE_HDR_SIZE (3u)
+#define RTT_RX_BATCH_CRC_SIZE       (2u)
+
+/* Smallest receive window content that can be parsed: a regular packet, or a
+ * batch with one 1-byte write
+ */
+#define RTT_RX_MIN_SIZE             (RTT_RX_BATCH_HDR_SIZE + RTT_RX_BATCH_WRITE_HDR_SIZE + 1u + \
+                                     RTT_RX_BATCH_CRC_SIZE + RTT_TX_TAIL_SIZE)
+
+/* rtt_tuner_apply_batch() results other than the batch length */
+#define RTT_RX_BATCH_INCOMPLETE     (0u)
+#define RTT_RX_BATCH_INVALID        (0xFFFFFFFFu)
+#else
+#define RTT_RX_MIN_SIZE             (CY_CAPSENSE_COMMAND_PACKET_SIZE)
+#endif
+
+#if (0u != RTT_TUNER_DELTA_EN)
+#define RTT_FRAME_TYPE_KEY          (0x00u)
+#define RTT_FRAME_TYPE_DELTA        (0x01u)
+
+/* Delta records cover whole 32-bit words, offset and length are in bytes */
+#define RTT_DELTA_RECORD_HDR_SIZE   (4u)
+#define RTT_DELTA_COUNT_SIZE        (2u)
+#define RTT_TUNER_WORDS             (sizeof(cy_capsense_tuner) / sizeof(uint32_t))
+
+_Static_assert((sizeof(cy_capsense_tuner) % sizeof(uint32_t)) == 0u, "Tuner structure must be word sized");
+_Static_assert(sizeof(cy_capsense_tuner) <= 0xFFFFu, "Tuner structure too large for 16-bit delta offsets");
+#endif
+
+#if (0u != RTT_TUNER_COMPACT_EN)
+#include "rtt_tuner_frame.h"
+
+#if (0u != RTT_TUNER_DELTA_EN) || (0u != RTT_TUNER_BENCHMARK_EN) || \
+    (0u != RTT_TUNER_SEQUENCE_EN) || (0u != RTT_TUNER_CRC_EN)
+#error "RTT_TUNER_COMPACT_EN cannot be combined with delta, benchmark, sequence or CRC frames"
+#endif
+
+#define RTT_TUNER_PAYLOAD_SIZE      (RTT_TUNER_FRAME_SIZE)
+#else
+#define RTT_TUNER_PAYLOAD_SIZE      (sizeof(cy_capsense_tuner))
+#endif
+
+#if (0u != RTT_TUNER_MULTIRATE_EN) && (0u == RTT_TUNER_COMPACT_EN)
+#error "RTT_TUNER_MULTIRATE_EN requires RTT_TUNER_COMPACT_EN (make COMPACT_FRAME=1)"
+#endif
+
+#if (0u != RTT_TUNER_ALIAS_EN) && \
+    ((0u != RTT_TUNER_DELTA_EN) || (0u != RTT_TUNER_COMPACT_EN) || (0u != RTT_TUNER_BENCHMARK_EN) || \
+     (0u != RTT_TUNER_SEQUENCE_EN) || (0u != RTT_TUNER_CRC_EN))
+#error "RTT_TUNER_ALIAS_EN cannot be combined with delta, compact, benchmark, sequence or CRC frames"
+#endif
+
+#if (0u != RTT_TUNER_DIRECT_EN) && ((0u == RTT_USE_FAST_RTT) || (0u != RTT_TUNER_ALIAS_EN) || \
+    (0u != RTT_TUNER_DELTA_EN) || (0u != RTT_TUNER_COMPACT_EN) || (0u != RTT_TUNER_BENCHMARK_EN) || \
+    (0u != RTT_TUNER_SEQUENCE_EN) || (0u != RTT_TUNER_CRC_EN))
+#error "RTT_TUNER_DIRECT_EN requires the snapshot transport and no other frame option"
+#endif
+
+#if (0u != RTT_TUNER_DMA_EN)
+#if !defined(CY_IP_M0S8CPUSSV3_DMAC)
+#error "RTT_TUNER_DMA_EN requires a device with a DMA controller"
+#endif
+
+#if !defined(RTT_TUNER_DMA_TRIGGER)
+#error "RTT_TUNER_DMA_EN requires RTT_TUNER_DMA_TRIGGER, the trigger line of RTT_TUNER_DMA_CHANNEL"
+#endif
+
+#if (0u == RTT_USE_FAST_RTT) || (0u != RTT_TUNER_ALIAS_EN) || (0u != RTT_TUNER_DIRECT_EN) || \
+    (0u != RTT_TUNER_DELTA_EN) || (0u != RTT_TUNER_COMPACT_EN) || (0u != RTT_TUNER_CRC_EN)
+#error "RTT_TUNER_DMA_EN requires the snapshot transport with complete frames and no CRC"
+#endif
+
+/* The channel copies half-words, an odd last byte would not be copied */
+_Static_assert((sizeof(cy_capsense_tuner) % sizeof(uint16_t)) == 0u, "RTT_TUNER_DMA_EN requires a tuner structure of whole half-words");
+
+/* The DMA interrupt is shared by all channels, each channel has one bit */
+#define RTT_TUNER_DMA_INTR_MASK     (1UL << RTT_TUNER_DMA_CHANNEL)
+#endif
+
+#if (RTT_TUNER_DOWN_BUF_SIZE <= CY_CAPSENSE_COMMAND_PACKET_SIZE)
+#error "RTT_TUNER_DOWN_BUF_SIZE must be larger than a command packet"
+#endif
+
+#if (0u == RTT_USE_FAST_RTT) || (0u != RTT_TUNER_BENCHMARK_EN)
+#define RTT_TUNER_TIMESTAMP_EN      (1u)
+#else
+#define RTT_TUNER_TIMESTAMP_EN      (0u)
+#endif
+
+#if (0u != RTT_TUNER_SEQUENCE_EN) || (0u != RTT_TUNER_BENCHMARK_EN)
+#define RTT_TUNER_SEQ_FIELD_EN      (1u)
+#else
+#define RTT_TUNER_SEQ_FIELD_EN      (0u)
+#endif
+
+#if (0u != RTT_TUNER_CRC_EN)
+#define RTT_TUNER_CRC_SIZE          (2u)
+#else
+#define RTT_TUNER_CRC_SIZE          (0u)
+#endif
+
+/* Frames and write batches share the CRC calculation */
+#if (0u != RTT_TUNER_CRC_EN) || (0u != RTT_TUNER_BATCH_EN)
+#define RTT_TUNER_CRC16_EN          (1u)
+#else
+#define RTT_TUNER_CRC16_EN          (0u)
+#endif
+
+#if (0u == RTT_USE_FAST_RTT) && (SEGGER_RTT_MODE_NO_BLOCK_TRIM == RTT_TUNER_UP_MODE)
+#error "RTT_TUNER_UP_MODE: trimming would split frames, use SKIP or BLOCK_IF_FIFO_FULL"
+#endif
+
+/* Snapshot transport ping-pongs between two frame buffers: the host reads one
+ * while the firmware fills the other, which is refilled only after the host
+ * has read the published one. Streaming needs a single staging frame, alias
+ * mode none.
+ */
+#if (0u != RTT_TUNER_ALIAS_EN) || (0u != RTT_TUNER_DIRECT_EN)
+#define RTT_TUNER_FRAME_BUFS        (0u)
+#elif (0u != RTT_USE_FAST_RTT)
+#define RTT_TUNER_FRAME_BUFS        (2u)
+#else
+#define RTT_TUNER_FRAME_BUFS        (1u)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Frame layout, all multi-byte fields are little-endian:
+ *  - header
+ *  - frame type and reserved byte (delta mode only)
+ *  - 16-bit frame descriptor ID (compact frame only)
+ *  - timestamp in CPU cycles (streaming transport or benchmark build)
+ *  - sequence number, incremented per frame built (sequence or benchmark)
+ *  - tuner data: the full cy_capsense_tuner structure (keyframe), or a 16-bit
+ *    record count followed by {16-bit offset, 16-bit length, data} records
+ *    (delta frame, followed directly by the CRC or the tail), or the
+ *    descriptor fields in order (compact frame)
+ *  - CRC-16 of all bytes before it (CRC only)
+ *  - tail
+ */
+typedef struct {
+    uint8_t header[2];
+#if (0u != RTT_TUNER_DELTA_EN)
+    uint8_t frame_type;
+    uint8_t reserved;
+#endif
+#if (0u != RTT_TUNER_COMPACT_EN)
+    uint8_t frame_id[2];
+#endif
+#if (0u != RTT_TUNER_TIMESTAMP_EN)
+    uint8_t timestamp[4];
+#endif
+#if (0u != RTT_TUNER_SEQ_FIELD_EN)
+    uint8_t sequence[4];
+#endif
+    uint8_t tuner_data[RTT_TUNER_PAYLOAD_SIZE];
+#if (0u != RTT_TUNER_CRC_EN)
+    uint8_t crc[RTT_TUNER_CRC_SIZE];
+#endif
+    uint8_t tail[RTT_TX_TAIL_SIZE];
+} rtt_tuner_data_t;
+
+#if (0u != RTT_TUNER_COMPACT_EN)
+/* Field of cy_capsense_tuner copied to the compact frame */
+typedef struct {
+    uint16_t offset;
+    uint8_t size;
+} rtt_tuner_field_t;
+#endif
+
+#if (0u != RTT_TUNER_MULTIRATE_EN)
+/* Slow channel frame: header, frame descriptor ID, size of the tuner data,
+ * the complete tuner data and the tail. Only the fields before the data are
+ * stored, the data is written to the up-buffer straight from cy_capsense_tuner.
+ */
+typedef struct {
+    uint8_t header[2];
+    uint8_t frame_id[2];
+    uint8_t size[2];
+} rtt_tuner_slow_header_t;
+
+#define RTT_TUNER_SLOW_FRAME_SIZE   (sizeof(rtt_tuner_slow_header_t) + sizeof(cy_capsense_tuner) + RTT_TX_TAIL_SIZE)
+#endif
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != RTT_TUNER_FRAME_BUFS)
+static uint32_t rtt_tuner_build_frame(rtt_tuner_data_t * frame);
+#endif
+#if (0u != RTT_USE_FAST_RTT) && (0u != RTT_TUNER_FRAME_BUFS)
+static void rtt_tuner_publish(rtt_tuner_data_t * frame, uint32_t length);
+#endif
+#if (0u != RTT_TUNER_COMPACT_EN)
+static void rtt_tuner_pack_fields(uint8_t * payload);
+#endif
+#if (0u != RTT_TUNER_MULTIRATE_EN)
+static void rtt_tuner_send_slow(void);
+#endif
+#if (0u != RTT_TUNER_CRC16_EN)
+static uint32_t rtt_tuner_crc16(const uint8_t * data, uint32_t length);
+#endif
+#if (0u != RTT_TUNER_BATCH_EN)
+static uint32_t rtt_tuner_apply_batch(const uint8_t * batch, uint32_t available);
+#endif
+#if (0u != RTT_TUNER_DMA_EN)
+static void rtt_tuner_dma_init(void);
+static void rtt_tuner_dma_start(rtt_tuner_data_t * frame);
+static void rtt_tuner_dma_isr(void);
+#endif
+#if (0u != RTT_TUNER_DELTA_EN)
+static uint32_t rtt_tuner_encode_delta(uint8_t * payload);
+static void rtt_tuner_apply_frame(const rtt_tuner_data_t * frame);
+#endif
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static uint8_t tuner_down_buf[RTT_TUNER_DOWN_BUF_SIZE];
+
+/* Receive window, drains the whole down-buffer in one read. Bytes between head
+ * and tail are received but not parsed yet.
+ */
+static uint8_t tuner_rx_window[sizeof(tuner_down_buf)];
+static uint32_t tuner_rx_head = 0u;
+static uint32_t tuner_rx_tail = 0u;
+
+#if (0u != RTT_TUNER_DELTA_EN)
+#define RTT_TUNER_UP_BUF_INIT   {                               \
+    .header = {RTT_TX_HEADER0, RTT_TX_HEADER1},                  \
+    .frame_type = RTT_FRAME_TYPE_KEY,                            \
+    .reserved = 0u,                                              \
+    .tuner_data = {0}                                            \
+}
+
+/* Copy of the tuner data as last seen by the host */
+static uint32_t tuner_shadow[RTT_TUNER_WORDS];
+static bool tuner_resync_request = true;
+static uint32_t tuner_frames_since_key = 0u;
+#elif (0u != RTT_TUNER_COMPACT_EN)
+#define RTT_TUNER_UP_BUF_INIT   {                               \
+    .header = {RTT_TX_HEADER0, RTT_TX_HEADER1},                  \
+    .frame_id = {(uint8_t)RTT_TUNER_FRAME_ID,                    \
+                 (uint8_t)(RTT_TUNER_FRAME_ID >> 8u)},           \
+    .tuner_data = {0},                                           \
+    .tail = {RTT_TX_TAIL0, RTT_TX_TAIL1, RTT_TX_TAIL2}           \
+}
+
+/* Generated from design.cycapsense, see tools/tuner_frame.py */
+static const rtt_tuner_field_t tuner_frame_fields[RTT_TUNER_FRAME_FIELDS] = RTT_TUNER_FRAME_DESCRIPTOR;
+#else
+#define RTT_TUNER_UP_BUF_INIT   {                               \
+    .header = {RTT_TX_HEADER0, RTT_TX_HEADER1},                  \
+    .tuner_data = {0},                                           \
+    .tail = {RTT_TX_TAIL0, RTT_TX_TAIL1, RTT_TX_TAIL2}           \
+}
+#endif
+
+#if (0u != RTT_TUNER_FRAME_BUFS)
+CY_ALIGN(RTT_BUFFER_ALIGNMENT) static rtt_tuner_data_t tuner_up_buf[RTT_TUNER_FRAME_BUFS] = {
+    RTT_TUNER_UP_BUF_INIT,
+#if (0u != RTT_USE_FAST_RTT)
+    RTT_TUNER_UP_BUF_INIT
+#endif
+};
+#elif (0u != RTT_TUNER_DIRECT_EN)
+/* The up-buffer of the tuner channel, the address fields are set at init */
+CY_ALIGN(RTT_BUFFER_ALIGNMENT) static rtt_tuner_direct_t tuner_direct = {
+    .header = {RTT_TX_HEADER0, RTT_TX_HEADER1},
+    .data_size = sizeof(cy_capsense_tuner),
+    .tail = {RTT_TX_TAIL0, RTT_TX_TAIL1, RTT_TX_TAIL2}
+};
+
+#define RTT_TUNER_DIRECT_SIZE       (offsetof(rtt_tuner_direct_t, tail) + RTT_TX_TAIL_SIZE)
+
+/* A command returned by rtt_tuner_receive() keeps the sequence odd until the
+ * next rtt_tuner_send(). Without one, the update of the main loop is left open.
+ */
+static bool tuner_direct_command = false;
+#elif (0u == RTT_USE_FAST_RTT)
+static const uint8_t tuner_tail[RTT_TX_TAIL_SIZE] = {RTT_TX_TAIL0, RTT_TX_TAIL1, RTT_TX_TAIL2};
+#endif
+
+#if (0u != RTT_USE_FAST_RTT) && (0u != RTT_TUNER_FRAME_BUFS)
+/* Index of the frame buffer currently published to the host */
+static uint32_t tuner_up_idx = 0u;
+#if (0u != RTT_TUNER_DELTA_EN)
+static bool tuner_frame_pending = false;
+#endif
+#else
+/* Up-buffer ring for the streaming transport */
+RTT_CHANNEL_BUFFER(tuner_stream_buf, RTT_TUNER_STREAM_FRAMES * sizeof(rtt_tuner_data_t));
+#endif
+
+#if (0u != RTT_TUNER_SEQ_FIELD_EN)
+static uint32_t tuner_sequence = 0u;
+#endif
+
+#if (0u != RTT_TUNER_DMA_EN)
+/* cy_capsense_tuner to frame copy in one transfer per trigger, the destination
+ * is set per frame. Halfword transfers, as the tuner data starts two bytes
+ * into the frame.
+ */
+static cy_stc_dmac_descriptor_config_t tuner_dma_descriptor = {
+    .retrigger = CY_DMAC_RETRIG_IM,
+    .triggerType = CY_DMAC_SINGLE_DESCR,
+    .dataSize = CY_DMAC_HALFWORD,
+    .srcTransferSize = CY_DMAC_TRANSFER_SIZE_DATA,
+    .srcAddrIncrement = true,
+    .dstTransferSize = CY_DMAC_TRANSFER_SIZE_DATA,
+    .dstAddrIncrement = true,
+    .interrupt = true,
+    .srcAddress = &cy_capsense_tuner,
+    .dstAddress = NULL,
+    .dataCount = sizeof(cy_capsense_tuner) / sizeof(uint16_t)
+};
+
+/* Frame the DMA is copying to, NULL when the channel is idle */
+static rtt_tuner_data_t * volatile tuner_dma_frame = NULL;
+#endif
+
+#if (0u != RTT_TUNER_CRC16_EN)
+/* CRC-16/CCITT-FALSE remainders of one nibble */
+static const uint16_t tuner_crc_table[16u] = {
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+#endif
+
+#if (0u != RTT_TUNER_MULTIRATE_EN)
+static const rtt_tuner_slow_header_t tuner_slow_header = {
+    .header = {RTT_TX_HEADER0, RTT_TX_HEADER1},
+    .frame_id = {(uint8_t)RTT_TUNER_FRAME_ID, (uint8_t)(RTT_TUNER_FRAME_ID >> 8u)},
+    .size = {(uint8_t)sizeof(cy_capsense_tuner), (uint8_t)(sizeof(cy_capsense_tuner) >> 8u)}
+};
+static const uint8_t tuner_slow_tail[RTT_TX_TAIL_SIZE] = {RTT_TX_TAIL0, RTT_TX_TAIL1, RTT_TX_TAIL2};
+
+/* Up-buffer of the slow channel holds one frame */
+RTT_CHANNEL_BUFFER(tuner_slow_buf, RTT_TUNER_SLOW_FRAME_SIZE);
+
+/* Frames until the next slow frame, 0: send with the next frame */
+static uint32_t tuner_slow_countdown = 0u;
+#endif
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the up and down buffers of the tuner channel. SEGGER_RTT_Init()
+ *  must have been called before.
+ *
+ *******************************************************************************/
+void rtt_tuner_init(void)
+{
+    /* Configure or add an up buffer by specifying its name, size and flags */
+#if (0u != RTT_TUNER_DIRECT_EN)
+    tuner_direct.data_address = (uint32_t)(uintptr_t)&cy_capsense_tuner;
+    tuner_direct.sequence_address = (uint32_t)(uintptr_t)&tuner_direct.sequence;
+    SEGGER_RTT_ConfigUpBuffer(RTT_TUNER_CHANNEL, "tuner", &tuner_direct, RTT_TUNER_DIRECT_SIZE + 1u, SEGGER_RTT_MODE_NO_BLOCK_TRIM);
+#elif (0u != RTT_USE_FAST_RTT) && (0u != RTT_TUNER_ALIAS_EN)
+    SEGGER_RTT_ConfigUpBuffer(RTT_TUNER_CHANNEL, "tuner", &cy_capsense_tuner, sizeof(cy_capsense_tuner) + 1, SEGGER_RTT_MODE_NO_BLOCK_TRIM);
+#elif (0u != RTT_USE_FAST_RTT)
+    SEGGER_RTT_ConfigUpBuffer(RTT_TUNER_CHANNEL, "tuner", &tuner_up_buf[0u], sizeof(rtt_tuner_data_t) + 1, SEGGER_RTT_MODE_NO_BLOCK_TRIM);
+#else
+    SEGGER_RTT_ConfigUpBuffer(RTT_TUNER_CHANNEL, "tuner", tuner_stream_buf, sizeof(tuner_stream_buf), RTT_TUNER_UP_MODE | SEGGER_RTT_FLAG_SINGLE_WRITER);
+#endif
+    /* Configure or add a down buffer by specifying its name, size and flags */
+    SEGGER_RTT_ConfigDownBuffer(RTT_TUNER_CHANNEL, "tuner", tuner_down_buf, sizeof(tuner_down_buf), SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL);
+#if (0u != RTT_TUNER_MULTIRATE_EN)
+    RTT_CHANNEL_CONFIG_UP(RTT_TUNER_SLOW_CHANNEL, "tuner-slow", tuner_slow_buf, RTT_CHANNEL_RECORD_FLAGS);
+#endif
+#if (0u != RTT_TUNER_DMA_EN)
+    rtt_tuner_dma_init();
+#endif
+}
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_send
+ ********************************************************************************
+ * Summary:
+ *  This function sends the CAPSENSE data to Tuner through RTT
+ *
+ *******************************************************************************/
+void rtt_tuner_send(void * context)
+{
+    (void)context;
+
+#if (0u != RTT_TUNER_DIRECT_EN)
+    SEGGER_RTT_BUFFER_UP *buffer = _SEGGER_RTT.aUp + RTT_TUNER_CHANNEL;
+
+    /* A command returned by rtt_tuner_receive() has been applied */
+    if (tuner_direct_command)
+    {
+        tuner_direct_command = false;
+        rtt_tuner_update_end();
+    }
+
+    /* Offer the descriptor with the current sequence to the host again */
+    SEGGER_RTT_LOCK();
+    buffer->WrOff = RTT_TUNER_DIRECT_SIZE;
+    buffer->RdOff = 0u;
+    SEGGER_RTT_UNLOCK();
+#elif (0u != RTT_USE_FAST_RTT) && (0u != RTT_TUNER_ALIAS_EN)
+    SEGGER_RTT_BUFFER_UP *buffer = _SEGGER_RTT.aUp + RTT_TUNER_CHANNEL;
+
+    /* The up-buffer is the tuner data itself, offer it to the host again */
+    SEGGER_RTT_LOCK();
+    buffer->WrOff = sizeof(cy_capsense_tuner);
+    buffer->RdOff = 0u;
+    SEGGER_RTT_UNLOCK();
+#elif (0u != RTT_TUNER_ALIAS_EN)
+    uint8_t prefix[offsetof(rtt_tuner_data_t, tuner_data)];
+    uint32_t now = timestamp_get();
+
+    prefix[0u] = RTT_TX_HEADER0;
+    prefix[1u] = RTT_TX_HEADER1;
+    prefix[2u] = (uint8_t)now;
+    prefix[3u] = (uint8_t)(now >> 8u);
+    prefix[4u] = (uint8_t)(now >> 16u);
+    prefix[5u] = (uint8_t)(now >> 24u);
+
+    /* Only the main loop writes this channel, so the lock is not needed. The
+     * frame is written in three parts without a staging copy, either when the
+     * ring has room for all of them or, in blocking mode, waiting for the host.
+     */
+    if ((SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL == RTT_TUNER_UP_MODE) ||
+        (SEGGER_RTT_GetAvailWriteSpace(RTT_TUNER_CHANNEL) >= sizeof(rtt_tuner_data_t)))
+    {
+        (void)SEGGER_RTT_WriteLockFree(RTT_TUNER_CHANNEL, prefix, sizeof(prefix));
+        (void)SEGGER_RTT_WriteLockFree(RTT_TUNER_CHANNEL, &cy_capsense_tuner, sizeof(cy_capsense_tuner));
+        (void)SEGGER_RTT_WriteLockFree(RTT_TUNER_CHANNEL, tuner_tail, sizeof(tuner_tail));
+    }
+#elif (0u != RTT_USE_FAST_RTT) && (0u != RTT_TUNER_DMA_EN)
+    SEGGER_RTT_BUFFER_UP *buffer = _SEGGER_RTT.aUp + RTT_TUNER_CHANNEL;
+    rtt_tuner_data_t * frame = &tuner_up_buf[tuner_up_idx ^ 1u];
+
+    /* The frame is published when the copy completes. If the previous copy
+     * is still running, or the host has not read the published frame yet (see
+     * below), this frame is skipped and the host keeps the last one.
+     */
+    if ((NULL == tuner_dma_frame) && (buffer->RdOff == buffer->WrOff))
+    {
+        (void)rtt_tuner_build_frame(frame);
+        rtt_tuner_dma_start(frame);
+    }
+#elif (0u != RTT_USE_FAST_RTT)
+    uint32_t length;
+    SEGGER_RTT_BUFFER_UP *buffer = _SEGGER_RTT.aUp + RTT_TUNER_CHANNEL;
+    rtt_tuner_data_t * frame = &tuner_up_buf[tuner_up_idx ^ 1u];
+
+    /* The idle buffer holds the previous publication, which a slow host may
+     * still be reading until it has read the current one. Until then the
+     * current frame stays published and this frame is skipped.
+     */
+    if (buffer->RdOff == buffer->WrOff)
+    {
+    #if (0u != RTT_TUNER_DELTA_EN)
+        /* The host has read the previous frame, so it now holds that state */
+        if (tuner_frame_pending)
+        {
+            rtt_tuner_apply_frame(&tuner_up_buf[tuner_up_idx]);
+        }
+    #endif
+
+        /* The host only reads the published buffer, so no lock is needed here */
+        length = rtt_tuner_build_frame(frame);
+        rtt_tuner_publish(frame, length);
+
+    #if (0u != RTT_TUNER_DELTA_EN)
+        tuner_frame_pending = true;
+    #endif
+    }
+#else
+    uint32_t length;
+    rtt_tuner_data_t * frame = &tuner_up_buf[0u];
+
+    length = rtt_tuner_build_frame(frame);
+
+    /* Only the main loop writes this channel, so the lock is not needed.
+     * The frame is written completely, or skipped or waited for according to
+     * RTT_TUNER_UP_MODE.
+     */
+    if (0u != SEGGER_RTT_WriteLockFree(RTT_TUNER_CHANNEL, frame, length))
+    {
+        #if (0u != RTT_TUNER_DELTA_EN)
+        rtt_tuner_apply_frame(frame);
+        #endif
+    }
+#endif
+
+#if (0u != RTT_TUNER_MULTIRATE_EN)
+    rtt_tuner_send_slow();
+#endif
+}
+
+
+#if (0u != RTT_TUNER_FRAME_BUFS)
+/*******************************************************************************
+ * Function Name: rtt_tuner_build_frame
+ ********************************************************************************
+ * Summary:
+ *  Fills a frame buffer with the current tuner data.
+ *
+ * Parameters:
+ *  frame: frame buffer that is not visible to the host
+ *
+ * Return:
+ *  Number of valid bytes in the frame
+ *
+ *******************************************************************************/
+static uint32_t rtt_tuner_build_frame(rtt_tuner_data_t * frame)
+{
+#if (0u != RTT_TUNER_TIMESTAMP_EN)
+    uint32_t now = timestamp_get();
+
+    frame->timestamp[0u] = (uint8_t)now;
+    frame->timestamp[1u] = (uint8_t)(now >> 8u);
+    frame->timestamp[2u] = (uint8_t)(now >> 16u);
+    frame->timestamp[3u] = (uint8_t)(now >> 24u);
+#endif
+#if (0u != RTT_TUNER_SEQ_FIELD_EN)
+    frame->sequence[0u] = (uint8_t)tuner_sequence;
+    frame->sequence[1u] = (uint8_t)(tuner_sequence >> 8u);
+    frame->sequence[2u] = (uint8_t)(tuner_sequence >> 16u);
+    frame->sequence[3u] = (uint8_t)(tuner_sequence >> 24u);
+    tuner_sequence++;
+#endif
+
+#if (0u != RTT_TUNER_CRC_EN)
+    uint32_t crc;
+#endif
+#if (0u != RTT_TUNER_DELTA_EN)
+    uint32_t length;
+    uint8_t * payload = (uint8_t *)frame + offsetof(rtt_tuner_data_t, tuner_data);
+
+    if (tuner_frames_since_key >= RTT_TUNER_KEYFRAME_INTERVAL)
+    {
+        tuner_resync_request = true;
+    }
+
+    length = tuner_resync_request ? 0u : rtt_tuner_encode_delta(payload);
+    if (0u != length)
+    {
+        frame->frame_type = RTT_FRAME_TYPE_DELTA;
+    }
+    else
+    {
+        /* Forced keyframe, or delta would not be smaller than a keyframe */
+        frame->frame_type = RTT_FRAME_TYPE_KEY;
+        memcpy(payload, &cy_capsense_tuner, sizeof(cy_capsense_tuner));
+        length = sizeof(cy_capsense_tuner);
+    }
+
+    #if (0u != RTT_TUNER_CRC_EN)
+    crc = rtt_tuner_crc16((const uint8_t *)frame, offsetof(rtt_tuner_data_t, tuner_data) + length);
+    payload[length++] = (uint8_t)crc;
+    payload[length++] = (uint8_t)(crc >> 8u);
+    #endif
+
+    payload[length]      = RTT_TX_TAIL0;
+    payload[length + 1u] = RTT_TX_TAIL1;
+    payload[length + 2u] = RTT_TX_TAIL2;
+
+    return offsetof(rtt_tuner_data_t, tuner_data) + length + RTT_TX_TAIL_SIZE;
+#elif (0u != RTT_TUNER_COMPACT_EN)
+    rtt_tuner_pack_fields(frame->tuner_data);
+
+    return sizeof(rtt_tuner_data_t);
+#else
+    #if (0u == RTT_TUNER_DMA_EN)
+    memcpy(frame->tuner_data, &cy_capsense_tuner, sizeof(cy_capsense_tuner));
+    #endif
+
+    #if (0u != RTT_TUNER_CRC_EN)
+    crc = rtt_tuner_crc16((const uint8_t *)frame, offsetof(rtt_tuner_data_t, crc));
+    frame->crc[0u] = (uint8_t)crc;
+    frame->crc[1u] = (uint8_t)(crc >> 8u);
+    #endif
+
+    return sizeof(rtt_tuner_data_t);
+#endif
+}
+#endif
+
+
+#if (0u != RTT_TUNER_CRC16_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_crc16
+ ********************************************************************************
+ * Summary:
+ *  Calculates the CRC-16/CCITT-FALSE of a frame or a write batch, one nibble
+ *  at a time. The
+ *  16-entry table keeps the flash cost at 32 bytes and takes about a quarter
+ *  of the cycles of the bitwise calculation.
+ *
+ * Parameters:
+ *  data: first byte
+ *  length: number of bytes
+ *
+ * Return:
+ *  CRC
+ *
+ *******************************************************************************/
+static uint32_t rtt_tuner_crc16(const uint8_t * data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFu;
+
+    while (0u != length--)
+    {
+        crc = ((crc << 4u) & 0xFFFFu) ^ tuner_crc_table[(crc >> 12u) ^ ((uint32_t)*data >> 4u)];
+        crc = ((crc << 4u) & 0xFFFFu) ^ tuner_crc_table[(crc >> 12u) ^ ((uint32_t)*data & 0x0Fu)];
+        data++;
+    }
+
+    return crc;
+}
+#endif
+
+
+#if (0u != RTT_TUNER_DMA_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_dma_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the DMA channel of the tuner data copy and its completion
+ *  interrupt.
+ *
+ *******************************************************************************/
+static void rtt_tuner_dma_init(void)
+{
+    static const cy_stc_dmac_channel_config_t dma_channel_config =
+    {
+        .descriptor = CY_DMAC_DESCRIPTOR_PING,
+        .preemptable = false,
+        .priority = 3u,
+        .enable = false,
+        .bufferable = false,
+    };
+
+    static const cy_stc_sysint_t dma_interrupt_config =
+    {
+        .intrSrc = cpuss_interrupt_dma_IRQn,
+        .intrPriority = RTT_TUNER_DMA_INTR_PRIORITY,
+    };
+
+    (void)Cy_DMAC_Channel_Init(DMAC, RTT_TUNER_DMA_CHANNEL, &dma_channel_config);
+    Cy_DMAC_SetInterruptMask(DMAC, Cy_DMAC_GetInterruptMask(DMAC) | RTT_TUNER_DMA_INTR_MASK);
+    Cy_DMAC_Enable(DMAC);
+
+    Cy_SysInt_Init(&dma_interrupt_config, rtt_tuner_dma_isr);
+    NVIC_ClearPendingIRQ(dma_interrupt_config.intrSrc);
+    NVIC_EnableIRQ(dma_interrupt_config.intrSrc);
+}
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_dma_start
+ ********************************************************************************
+ * Summary:
+ *  Starts the copy of the tuner data into a frame whose header has been
+ *  filled. The copy of a few hundred bytes completes long before the first
+ *  sensor of the next scan updates the tuner data.
+ *
+ * Parameters:
+ *  frame: frame buffer that is not published
+ *
+ *******************************************************************************/
+static void rtt_tuner_dma_start(rtt_tuner_data_t * frame)
+{
+    tuner_dma_frame = frame;
+
+    tuner_dma_descriptor.dstAddress = frame->tuner_data;
+    (void)Cy_DMAC_Descriptor_Init(DMAC, RTT_TUNER_DMA_CHANNEL, CY_DMAC_DESCRIPTOR_PING, &tuner_dma_descriptor);
+    Cy_DMAC_Channel_SetCurrentDescriptor(DMAC, RTT_TUNER_DMA_CHANNEL, CY_DMAC_DESCRIPTOR_PING);
+    Cy_DMAC_Channel_Enable(DMAC, RTT_TUNER_DMA_CHANNEL);
+
+    (void)Cy_TrigMux_SwTrigger(RTT_TUNER_DMA_TRIGGER, CY_TRIGGER_TWO_CYCLES);
+}
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_dma_isr
+ ********************************************************************************
+ * Summary:
+ *  DMA completion interrupt: publishes the frame the tuner data was copied to.
+ *
+ *******************************************************************************/
+static void rtt_tuner_dma_isr(void)
+{
+    rtt_tuner_data_t * frame = tuner_dma_frame;
+
+    if (0u != (Cy_DMAC_GetInterruptStatusMasked(DMAC) & RTT_TUNER_DMA_INTR_MASK))
+    {
+        Cy_DMAC_ClearInterrupt(DMAC, RTT_TUNER_DMA_INTR_MASK);
+
+        if (NULL != frame)
+        {
+            rtt_tuner_publish(frame, sizeof(rtt_tuner_data_t));
+            tuner_dma_frame = NULL;
+        }
+    }
+}
+#endif
+
+
+#if (0u != RTT_USE_FAST_RTT) && (0u != RTT_TUNER_FRAME_BUFS)
+/*******************************************************************************
+ * Function Name: rtt_tuner_publish
+ ********************************************************************************
+ * Summary:
+ *  Points the tuner up-buffer at a completely filled frame buffer. For frames
+ *  of constant size only pBuffer changes, which is a single word store. The
+ *  caller fills the buffer only after the host has read the current
+ *  publication (RdOff == WrOff), so the host is done with the buffer and never
+ *  sees a partially written frame. The interrupt-off window is a few stores
+ *  regardless of the tuner data size.
+ *
+ * Parameters:
+ *  frame: filled frame buffer that is not currently published
+ *  length: number of valid bytes in the frame
+ *
+ *******************************************************************************/
+static void rtt_tuner_publish(rtt_tuner_data_t * frame, uint32_t length)
+{
+    SEGGER_RTT_BUFFER_UP *buffer = _SEGGER_RTT.aUp + RTT_TUNER_CHANNEL;
+
+    SEGGER_RTT_LOCK();
+    buffer->pBuffer = (char *)frame;
+    buffer->WrOff = length;
+    buffer->RdOff = 0u;
+    SEGGER_RTT_UNLOCK();
+
+    tuner_up_idx ^= 1u;
+}
+#endif
+
+
+#if (0u != RTT_TUNER_COMPACT_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_pack_fields
+ ********************************************************************************
+ * Summary:
+ *  Copies the fields listed in the frame descriptor from the tuner data to the
+ *  compact frame, back to back. Fields are 1 or 2 bytes wide.
+ *
+ * Parameters:
+ *  payload: destination, RTT_TUNER_FRAME_SIZE bytes
+ *
+ *******************************************************************************/
+static void rtt_tuner_pack_fields(uint8_t * payload)
+{
+    const uint8_t * live = (const uint8_t *)&cy_capsense_tuner;
+    const rtt_tuner_field_t * field;
+    uint32_t i;
+
+    for (i = 0u; i < RTT_TUNER_FRAME_FIELDS; i++)
+    {
+        field = &tuner_frame_fields[i];
+        payload[0u] = live[field->offset];
+        if (1u < field->size)
+        {
+            payload[1u] = live[field->offset + 1u];
+        }
+        payload += field->size;
+    }
+}
+#endif
+
+
+#if (0u != RTT_TUNER_DIRECT_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_update_begin
+ ********************************************************************************
+ * Summary:
+ *  Makes the sequence counter odd before the firmware starts a scan or
+ *  modifies the tuner data otherwise. The host discards the data it read while the counter was odd or changed.
+ *  Does nothing if an update is already in progress.
+ *
+ *******************************************************************************/
+void rtt_tuner_update_begin(void)
+{
+    if (0u == (tuner_direct.sequence & 1u))
+    {
+        tuner_direct.sequence++;
+        __DMB();
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_update_end
+ ********************************************************************************
+ * Summary:
+ *  Makes the sequence counter even again once the tuner data is consistent.
+ *
+ *******************************************************************************/
+void rtt_tuner_update_end(void)
+{
+    if (0u != (tuner_direct.sequence & 1u))
+    {
+        __DMB();
+        tuner_direct.sequence++;
+    }
+}
+#endif
+
+
+#if (0u != RTT_TUNER_MULTIRATE_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_send_slow
+ ********************************************************************************
+ * Summary:
+ *  Sends the complete tuner data on the slow channel when the interval has
+ *  elapsed or a tuner command was received. The frame is written in three
+ *  parts once the up-buffer has room for all of them, so it is never split by
+ *  a skip. If the host has not read the previous slow frame yet, it is tried
+ *  again with the next frame.
+ *
+ *******************************************************************************/
+static void rtt_tuner_send_slow(void)
+{
+    if (0u != tuner_slow_countdown)
+    {
+        tuner_slow_countdown--;
+    }
+    else if (SEGGER_RTT_GetAvailWriteSpace(RTT_TUNER_SLOW_CHANNEL) >= RTT_TUNER_SLOW_FRAME_SIZE)
+    {
+        RTT_CHANNEL_WRITE(RTT_TUNER_SLOW_CHANNEL, &tuner_slow_header, sizeof(tuner_slow_header));
+        RTT_CHANNEL_WRITE(RTT_TUNER_SLOW_CHANNEL, &cy_capsense_tuner, sizeof(cy_capsense_tuner));
+        RTT_CHANNEL_WRITE(RTT_TUNER_SLOW_CHANNEL, tuner_slow_tail, sizeof(tuner_slow_tail));
+        tuner_slow_countdown = RTT_TUNER_SLOW_INTERVAL - 1u;
+    }
+}
+#endif
+
+
+#if (0u != RTT_TUNER_DELTA_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_encode_delta
+ ********************************************************************************
+ * Summary:
+ *  Compares the live tuner data with the shadow word by word and writes the
+ *  changed regions as delta records. Regions separated by a single unchanged
+ *  word are merged, as a new record header costs as much as that word.
+ *
+ * Parameters:
+ *  payload: destination for the record count and the records
+ *
+ * Return:
+ *  Payload length in bytes, or 0 when a keyframe is not larger than the delta
+ *
+ *******************************************************************************/
+static uint32_t rtt_tuner_encode_delta(uint8_t * payload)
+{
+    const uint32_t * live = (const uint32_t *)(const void *)&cy_capsense_tuner;
+    uint32_t pos = RTT_DELTA_COUNT_SIZE;
+    uint32_t count = 0u;
+    uint32_t start;
+    uint32_t end;
+    uint32_t i = 0u;
+
+    while (i < RTT_TUNER_WORDS)
+    {
+        if (live[i] == tuner_shadow[i])
+        {
+            i++;
+            continue;
+        }
+
+        start = i;
+        end = i + 1u;
+        for (i = end; (i < RTT_TUNER_WORDS) && (i <= (end + 1u)); i++)
+        {
+            if (live[i] != tuner_shadow[i])
+            {
+                end = i + 1u;
+            }
+        }
+        i = end;
+
+        start *= sizeof(uint32_t);
+        end *= sizeof(uint32_t);
+        if ((pos + RTT_DELTA_RECORD_HDR_SIZE + (end - start)) >= sizeof(cy_capsense_tuner))
+        {
+            return 0u;
+        }
+
+        payload[pos++] = (uint8_t)start;
+        payload[pos++] = (uint8_t)(start >> 8u);
+        payload[pos++] = (uint8_t)(end - start);
+        payload[pos++] = (uint8_t)((end - start) >> 8u);
+        memcpy(&payload[pos], (const uint8_t *)live + start, end - start);
+        pos += end - start;
+        count++;
+    }
+
+    payload[0u] = (uint8_t)count;
+    payload[1u] = (uint8_t)(count >> 8u);
+
+    return pos;
+}
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_apply_frame
+ ********************************************************************************
+ * Summary:
+ *  Applies a frame the host has consumed to the shadow, so that the next delta
+ *  is computed against the state the host actually holds.
+ *
+ * Parameters:
+ *  frame: consumed key or delta frame
+ *
+ *******************************************************************************/
+static void rtt_tuner_apply_frame(const rtt_tuner_data_t * frame)
+{
+    const uint8_t * payload = (const uint8_t *)frame + offsetof(rtt_tuner_data_t, tuner_data);
+    const uint8_t * rec = &payload[RTT_DELTA_COUNT_SIZE];
+    uint32_t count;
+    uint32_t offset;
+    uint32_t length;
+
+    if (RTT_FRAME_TYPE_KEY == frame->frame_type)
+    {
+        memcpy(tuner_shadow, payload, sizeof(tuner_shadow));
+        tuner_resync_request = false;
+        tuner_frames_since_key = 0u;
+        return;
+    }
+
+    tuner_frames_since_key++;
+
+    count = (uint32_t)payload[0u] | ((uint32_t)payload[1u] << 8u);
+    while (0u != count--)
+    {
+        offset = (uint32_t)rec[0u] | ((uint32_t)rec[1u] << 8u);
+        length = (uint32_t)rec[2u] | ((uint32_t)rec[3u] << 8u);
+        rec += RTT_DELTA_RECORD_HDR_SIZE;
+        memcpy((uint8_t *)tuner_shadow + offset, rec, length);
+        rec += length;
+    }
+}
+#endif
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_receive
+ ********************************************************************************
+ * Summary:
+ *  RTT receives the Tuner command. All bytes available in the down-buffer are
+ *  read at once into the receive window, which is then scanned in place for
+ *  valid command packets. One packet is returned per call, the remaining
+ *  packets stay in the window for the following calls. Write batches are
+ *  applied by this function and not returned.
+ *
+ *******************************************************************************/
+void rtt_tuner_receive(uint8_t ** packet, uint8_t ** tuner_packet, void * context)
+{
+    uint8_t * candidate;
+#if (0u != RTT_TUNER_BATCH_EN)
+    uint32_t length;
+#endif
+
+    (void)context;
+
+    /* Drop the bytes already parsed, less than one packet or a partly received
+     * batch remains. A linear window instead of a circular index: the packet
+     * returned to the middleware, Cy_CapSense_CheckTunerCmdIntegrity() and the
+     * batch parser all need the bytes contiguous, and a wrapped packet would
+     * be copied anyway. The move covers only this remainder.
+     */
+    if (0u != tuner_rx_head)
+    {
+        tuner_rx_tail -= tuner_rx_head;
+        memmove(tuner_rx_window, &tuner_rx_window[tuner_rx_head], tuner_rx_tail);
+        tuner_rx_head = 0u;
+    }
+
+    /* Only the main loop reads this channel, so the lock is not needed */
+    tuner_rx_tail += SEGGER_RTT_ReadNoLock(RTT_TUNER_CHANNEL, &tuner_rx_window[tuner_rx_tail],
+                                           sizeof(tuner_rx_window) - tuner_rx_tail);
+
+    while ((tuner_rx_tail - tuner_rx_head) >= RTT_RX_MIN_SIZE)
+    {
+        candidate = &tuner_rx_window[tuner_rx_head];
+
+        #if (0u != RTT_TUNER_BATCH_EN)
+        if ((RTT_RX_HEADER0 == candidate[0u]) && (RTT_RX_BATCH_HEADER1 == candidate[1u]))
+        {
+            length = rtt_tuner_apply_batch(candidate, tuner_rx_tail - tuner_rx_head);
+            if (RTT_RX_BATCH_INCOMPLETE == length)
+            {
+                /* Wait for the rest of the batch */
+                break;
+            }
+            if (RTT_RX_BATCH_INVALID == length)
+            {
+                tuner_rx_head++;
+                continue;
+            }
+            tuner_rx_head += length;
+
+            #if (0u != RTT_TUNER_MULTIRATE_EN)
+            tuner_slow_countdown = 0u;
+            #endif
+
+            /* The middleware is not involved, look for a regular packet */
+            continue;
+        }
+
+        if ((tuner_rx_tail - tuner_rx_head) < CY_CAPSENSE_COMMAND_PACKET_SIZE)
+        {
+            break;
+        }
+        #endif
+
+        /* Check the header first to skip the CRC calculation for most offsets */
+        if ((RTT_RX_HEADER0 != candidate[0u]) || (RTT_RX_HEADER1 != candidate[1u]) ||
+            (CY_CAPSENSE_COMMAND_OK != Cy_CapSense_CheckTunerCmdIntegrity(candidate)))
+        {
+            tuner_rx_head++;
+            continue;
+        }
+
+        tuner_rx_head += CY_CAPSENSE_COMMAND_PACKET_SIZE;
+
+        #if (0u != TUNING_STORE_EN)
+        /* Handled locally, the flash is written by the main loop */
+        if (RTT_TUNER_CMD_SAVE_PROFILE == candidate[CY_CAPSENSE_COMMAND_CODE_0_IDX])
+        {
+            tuning_store_request(TUNING_STORE_REQUEST_SAVE);
+            continue;
+        }
+        if (RTT_TUNER_CMD_ERASE_PROFILE == candidate[CY_CAPSENSE_COMMAND_CODE_0_IDX])
+        {
+            tuning_store_request(TUNING_STORE_REQUEST_ERASE);
+            continue;
+        }
+        #endif
+
+        #if (0u != RTT_TUNER_DELTA_EN)
+        if (RTT_TUNER_CMD_RESYNC == candidate[CY_CAPSENSE_COMMAND_CODE_0_IDX])
+        {
+            /* Handled locally, the middleware does not know this command */
+            tuner_resync_request = true;
+            continue;
+        }
+        if ((CY_CAPSENSE_TU_CMD_RESUME_E == candidate[CY_CAPSENSE_COMMAND_CODE_0_IDX]) ||
+            (CY_CAPSENSE_TU_CMD_RESTART_E == candidate[CY_CAPSENSE_COMMAND_CODE_0_IDX]))
+        {
+            tuner_resync_request = true;
+        }
+        #endif
+
+        #if (0u != RTT_TUNER_MULTIRATE_EN)
+        /* Commands may change the calibration or configuration */
+        tuner_slow_countdown = 0u;
+        #endif
+
+        #if (0u != RTT_TUNER_DIRECT_EN)
+        /* The middleware writes the command to the tuner data before the next
+         * rtt_tuner_send()
+         */
+        tuner_direct_command = true;
+        rtt_tuner_update_begin();
+        #endif
+
+        /* The packet stays valid until the next call */
+        *tuner_packet = (uint8_t *)&cy_capsense_tuner;
+        *packet = candidate;
+        break;
+    }
+}
+
+
+#if (0u != RTT_TUNER_BATCH_EN)
+/*******************************************************************************
+ * Function Name: rtt_tuner_apply_batch
+ ********************************************************************************
+ * Summary:
+ *  Checks a write batch at the start of the receive window and, only if the
+ *  complete batch is valid, writes all its parameters to the tuner data. The
+ *  main loop runs the tuner between two scans, so a scan never sees a part of
+ *  the batch.
+ *
+ * Parameters:
+ *  batch: first byte of the batch header
+ *  available: number of received bytes from the batch header on
+ *
+ * Return:
+ *  Length of the applied batch in bytes, RTT_RX_BATCH_INCOMPLETE if more bytes
+ *  are needed, or RTT_RX_BATCH_INVALID if this is not a valid batch
+ *
+ *******************************************************************************/
+static uint32_t rtt_tuner_apply_batch(const uint8_t * batch, uint32_t available)
+{
+    uint32_t count = batch[2u];
+    uint32_t pos = RTT_RX_BATCH_HDR_SIZE;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t i;
+
+    if (0u == count)
+    {
+        return RTT_RX_BATCH_INVALID;
+    }
+
+    /* Walk and check the writes */
+    for (i = 0u; i < count; i++)
+    {
+        if ((pos + RTT_RX_BATCH_WRITE_HDR_SIZE) > available)
+        {
+            break;
+        }
+        offset = (uint32_t)batch[pos] | ((uint32_t)batch[pos + 1u] << 8u);
+        size = batch[pos + 2u];
+        if ((0u == size) || ((offset + size) > sizeof(cy_capsense_tuner)))
+        {
+            return RTT_RX_BATCH_INVALID;
+        }
+        pos += RTT_RX_BATCH_WRITE_HDR_SIZE + size;
+    }
+
+    if ((i < count) || ((pos + RTT_RX_BATCH_CRC_SIZE + RTT_TX_TAIL_SIZE) > available))
+    {
+        /* A batch that does not fit the receive window never completes */
+        return (available >= sizeof(tuner_rx_window)) ? RTT_RX_BATCH_INVALID : RTT_RX_BATCH_INCOMPLETE;
+    }
+
+    crc = (uint32_t)batch[pos] | ((uint32_t)batch[pos + 1u] << 8u);
+    if ((crc != rtt_tuner_crc16(batch, pos)) ||
+        (RTT_TX_TAIL0 != batch[pos + 2u]) || (RTT_TX_TAIL1 != batch[pos + 3u]) || (RTT_TX_TAIL2 != batch[pos + 4u]))
+    {
+        return RTT_RX_BATCH_INVALID;
+    }
+
+    #if (0u != RTT_TUNER_DIRECT_EN)
+    /* Ends with the next rtt_tuner_send() */
+    rtt_tuner_update_begin();
+    #endif
+
+    pos = RTT_RX_BATCH_HDR_SIZE;
+    for (i = 0u; i < count; i++)
+    {
+        offset = (uint32_t)batch[pos] | ((uint32_t)batch[pos + 1u] << 8u);
+        size = batch[pos + 2u];
+        memcpy((uint8_t *)&cy_capsense_tuner + offset, &batch[pos + RTT_RX_BATCH_WRITE_HDR_SIZE], size);
+        pos += RTT_RX_BATCH_WRITE_HDR_SIZE + size;
+    }
+
+    return pos + RTT_RX_BATCH_CRC_SIZE + RTT_TX_TAIL_SIZE;
+}
+#endif
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_host_connected
+ ********************************************************************************
+ * Summary:
+ *  Checks whether a host uses the tuner channel: it has read from the tuner
+ *  up-buffer, which needs a frame to have been sent, or written to the tuner
+ *  down-buffer. Once true, stays true.
+ *
+ * Return:
+ *  true if a host has connected
+ *
+ *******************************************************************************/
+bool rtt_tuner_host_connected(void)
+{
+    static bool connected = false;
+
+    if (!connected)
+    {
+        connected = ((0u != _SEGGER_RTT.aUp[RTT_TUNER_CHANNEL].RdOff) ||
+                     (0u != SEGGER_RTT_HASDATA(RTT_TUNER_CHANNEL)));
+    }
+
+    return connected;
+}
+
+
+/*******************************************************************************
+ * Function Name: rtt_tuner_command_pending
+ ********************************************************************************
+ * Summary:
+ *  Checks whether more command data is queued, either in the receive window or
+ *  in the RTT down-buffer, so that the caller can run the tuner again in the
+ *  same loop iteration.
+ *
+ * Return:
+ *  true if rtt_tuner_receive() may return another command
+ *
+ *******************************************************************************/
+bool rtt_tuner_command_pending(void)
+{
+    return (((tuner_rx_tail - tuner_rx_head) >= CY_CAPSENSE_COMMAND_PACKET_SIZE) ||
+            (0u != SEGGER_RTT_HASDATA(RTT_TUNER_CHANNEL)));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * File Name: rtt_tuner.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the RTT transport between the CAPSENSE middleware and the CAPSENSE Tuner.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef RTT_TUNER_H
+#define RTT_TUNER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+
+/*******************************************************************************
+ * User configurable Macros for RTT
+ ********************************************************************************/
+/* Tuner transport selection:
+ * 1 - Snapshot: the up-buffer holds the latest frame, which the host polls.
+ *     The next frame is published after the host has read it, scans in
+ *     between are skipped. Compatible with the CAPSENSE Tuner GUI.
+ * 0 - Streaming: every frame is appended to an up-buffer ring together with a
+ *     timestamp, so the host can record every scan. A frame is skipped if the
+ *     ring does not have enough free space.
+ */
+#ifndef RTT_USE_FAST_RTT
+#define RTT_USE_FAST_RTT  1
+#endif
+
+/* Number of frames the streaming ring can hold */
+#ifndef RTT_TUNER_STREAM_FRAMES
+#define RTT_TUNER_STREAM_FRAMES     (4u)
+#endif
+
+/* Behavior of the streaming transport when the ring is full:
+ * SEGGER_RTT_MODE_NO_BLOCK_SKIP      - the frame is skipped
+ * SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL - the main loop waits for the host
+ */
+#ifndef RTT_TUNER_UP_MODE
+#define RTT_TUNER_UP_MODE           SEGGER_RTT_MODE_NO_BLOCK_SKIP
+#endif
+
+/* Every frame carries a 32-bit sequence number, incremented per frame built,
+ * so the host can detect duplicate reads and missed frames. Not compatible
+ * with the CAPSENSE Tuner GUI.
+ */
+#ifndef RTT_TUNER_SEQUENCE_EN
+#define RTT_TUNER_SEQUENCE_EN       (0u)
+#endif
+
+/* Every frame carries a CRC-16/CCITT-FALSE (polynomial 0x1021, initial value
+ * 0xFFFF) of the bytes from the header to the end of the tuner data, before
+ * the tail. Not compatible with the CAPSENSE Tuner GUI.
+ */
+#ifndef RTT_TUNER_CRC_EN
+#define RTT_TUNER_CRC_EN            (0u)
+#endif
+
+/* Benchmark build: every frame carries a timestamp and a 32-bit sequence
+ * number so that tools/rtt_benchmark.py can measure the frame rate, dropped
+ * frames and latency. Not compatible with the CAPSENSE Tuner GUI.
+ */
+#ifndef RTT_TUNER_BENCHMARK_EN
+#define RTT_TUNER_BENCHMARK_EN      (0u)
+#endif
+
+/* Delta mode: send only the regions of cy_capsense_tuner that changed since
+ * the last frame consumed by the host. Requires a host decoder that
+ * understands the key/delta frame format, so it is disabled by default to
+ * stay compatible with the CAPSENSE Tuner GUI.
+ */
+#ifndef RTT_TUNER_DELTA_EN
+#define RTT_TUNER_DELTA_EN          (0u)
+#endif
+
+/* Compact frame: send only the per-scan fields of the widgets and sensors in
+ * the CAPSENSE design, as listed by the frame descriptor that
+ * tools/tuner_frame.py generates from design.cycapsense (make
+ * COMPACT_FRAME=1). Requires a host decoder that reads the same descriptor,
+ * so it is disabled by default to stay compatible with the CAPSENSE Tuner GUI.
+ */
+#ifndef RTT_TUNER_COMPACT_EN
+#define RTT_TUNER_COMPACT_EN        (0u)
+#endif
+
+/* Multi-rate output, requires RTT_TUNER_COMPACT_EN: the compact frame on the
+ * tuner channel carries the per-scan signals, and the complete tuner data,
+ * which holds the rarely changing calibration and configuration, is sent on
+ * RTT_TUNER_SLOW_CHANNEL every RTT_TUNER_SLOW_INTERVAL frames and after each
+ * tuner command.
+ */
+#ifndef RTT_TUNER_MULTIRATE_EN
+#define RTT_TUNER_MULTIRATE_EN      (0u)
+#endif
+
+#ifndef RTT_TUNER_SLOW_INTERVAL
+#define RTT_TUNER_SLOW_INTERVAL     (100u)
+#endif
+
+/* Alias mode, for the memory budget profile: no frame buffer is allocated.
+ * The snapshot transport points the up-buffer straight at cy_capsense_tuner,
+ * so the host reads the bare tuner data without header and tail, and may see
+ * it while the firmware updates it. The streaming transport writes header,
+ * tuner data and tail directly to the ring. Not compatible with the CAPSENSE
+ * Tuner GUI when combined with the snapshot transport.
+ */
+#ifndef RTT_TUNER_ALIAS_EN
+#define RTT_TUNER_ALIAS_EN          (0u)
+#endif
+
+/* Direct mode, snapshot transport only: the tuner up-buffer holds a small
+ * descriptor with the address and size of cy_capsense_tuner and a sequence
+ * counter, and the host reads the live tuner data from memory with no copy
+ * on the target. The counter is odd while the firmware updates the tuner
+ * data, so the host detects and discards torn reads. Not compatible with the
+ * CAPSENSE Tuner GUI.
+ */
+#ifndef RTT_TUNER_DIRECT_EN
+#define RTT_TUNER_DIRECT_EN         (0u)
+#endif
+
+/* DMA copy, snapshot transport on devices with a DMA controller: the tuner
+ * data is copied to the frame buffer by DMA channel RTT_TUNER_DMA_CHANNEL and
+ * the frame is published in the DMA completion interrupt, so the CPU can
+ * start the next scan while the copy runs. The channel is started through a
+ * software trigger on RTT_TUNER_DMA_TRIGGER, the trigger multiplexer output
+ * routed to the input of the channel (TRIG_OUT_MUX_* in the device header),
+ * which has no default and must be defined when the copy is enabled.
+ */
+#ifndef RTT_TUNER_DMA_EN
+#define RTT_TUNER_DMA_EN            (0u)
+#endif
+
+#ifndef RTT_TUNER_DMA_CHANNEL
+#define RTT_TUNER_DMA_CHANNEL       (0u)
+#endif
+
+#ifndef RTT_TUNER_DMA_INTR_PRIORITY
+#define RTT_TUNER_DMA_INTR_PRIORITY (3u)
+#endif
+
+/* Batched writes: besides regular command packets, the down-buffer accepts a
+ * batch of parameter writes to the tuner data with a single CRC, which is
+ * applied as a whole between two scans, see tools/tuner_batch.py.
+ */
+#ifndef RTT_TUNER_BATCH_EN
+#define RTT_TUNER_BATCH_EN          (0u)
+#endif
+
+/* Size of the tuner down-buffer and of the receive window. Must hold at least
+ * one command packet, and limits the size of a batch.
+ */
+#ifndef RTT_TUNER_DOWN_BUF_SIZE
+#if (0u != RTT_TUNER_BATCH_EN)
+#define RTT_TUNER_DOWN_BUF_SIZE     (256u)
+#else
+#define RTT_TUNER_DOWN_BUF_SIZE     (32u)
+#endif
+#endif
+
+/* Number of delta frames delivered to the host between two keyframes */
+#ifndef RTT_TUNER_KEYFRAME_INTERVAL
+#define RTT_TUNER_KEYFRAME_INTERVAL (32u)
+#endif
+
+/* Maximum number of queued Tuner commands processed per scan */
+#ifndef RTT_TUNER_MAX_COMMANDS
+#define RTT_TUNER_MAX_COMMANDS      (4u)
+#endif
+
+/* Command code the host sends in a regular command packet to request a keyframe */
+#define RTT_TUNER_CMD_RESYNC        (0x80u)
+
+/* Command codes of regular command packets that save the current tuning
+ * parameters to flash or erase them, see tuning_store.h
+ */
+#define RTT_TUNER_CMD_SAVE_PROFILE  (0x81u)
+#define RTT_TUNER_CMD_ERASE_PROFILE (0x82u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Direct mode descriptor, all fields are little-endian */
+typedef struct {
+    uint8_t  header[2];
+    uint8_t  reserved[2];
+    uint32_t sequence;          /* Odd while the tuner data is updated */
+    uint32_t data_address;      /* Address of cy_capsense_tuner */
+    uint32_t data_size;         /* sizeof(cy_capsense_tuner) */
+    uint32_t sequence_address;  /* Address of the sequence field above */
+    uint8_t  tail[3];
+} rtt_tuner_direct_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void rtt_tuner_init(void);
+void rtt_tuner_send(void * context);
+void rtt_tuner_receive(uint8_t ** packet, uint8_t ** tuner_packet, void * context);
+bool rtt_tuner_command_pending(void);
+bool rtt_tuner_host_connected(void);
+
+#if (0u != RTT_TUNER_DIRECT_EN)
+void rtt_tuner_update_begin(void);
+void rtt_tuner_update_end(void);
+
+#define RTT_TUNER_UPDATE_BEGIN()    rtt_tuner_update_begin()
+#define RTT_TUNER_UPDATE_END()      rtt_tuner_update_end()
+#else
+#define RTT_TUNER_UPDATE_BEGIN()
+#define RTT_TUNER_UPDATE_END()
+#endif
+
+#endif /* RTT_TUNER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,452 @@
+/******************************************************************************
+ * File Name: scan_scheduler.c
+ *
+ * Description: This file contains the adaptive scan scheduler, which scans all
+ * widgets at full rate while the user interacts and a single widget
+ * at a time when idle.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "scan_scheduler.h"
+
+#if (0u != SCAN_SCHEDULER_EN)
+#include "timestamp.h"
+#define DEFERRED_LOG_MODULE             (2u)
+#include "deferred_log.h"
+#if (0u != SCAN_LOW_POWER_EN)
+#include "cybsp.h"
+#include "rtt_tuner.h"
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+#endif
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#if (SCAN_WAKE_ROUND_ROBIN != SCAN_WAKE_WIDGET) && (SCAN_WAKE_WIDGET >= CY_CAPSENSE_WIDGET_COUNT)
+#error "SCAN_WAKE_WIDGET is not a widget of the CAPSENSE configuration"
+#endif
+
+#if (0u != SCAN_LOW_POWER_EN)
+/* WDT ticks per idle period and per status period */
+#define SCAN_WDT_PERIOD_TICKS           ((SCAN_IDLE_PERIOD_MS * SCAN_ILO_HZ) / 1000u)
+#define SCAN_STATUS_PERIOD_TICKS        ((SCAN_STATUS_PERIOD_MS * SCAN_ILO_HZ) / 1000uL)
+
+/* The WDT counter has 16 bits, and tick deltas are taken at least once per
+ * idle period
+ */
+#define SCAN_WDT_COUNTER_MASK           (0xFFFFu)
+
+#if (SCAN_WDT_PERIOD_TICKS == 0u) || (SCAN_WDT_PERIOD_TICKS > (SCAN_WDT_COUNTER_MASK / 2u))
+#error "SCAN_IDLE_PERIOD_MS out of the WDT range"
+#endif
+
+#define SCAN_STATUS_BUF_RECORDS         (4u)
+#endif
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static scan_scheduler_state_t scheduler_state = SCAN_SCHEDULER_ACTIVE;
+
+/* Widget scanned when idle */
+static uint32_t scheduler_widget = 0u;
+
+/* Timestamps of the last touch and of the last scan start */
+static uint32_t scheduler_last_touch = 0u;
+static uint32_t scheduler_last_scan = 0u;
+
+/* Timing converted to CPU cycles */
+static uint32_t scheduler_timeout_cycles = 0u;
+static uint32_t scheduler_period_cycles = 0u;
+
+#if (0u != SCAN_LOW_POWER_EN)
+RTT_CHANNEL_BUFFER(scheduler_status_buf, SCAN_STATUS_BUF_RECORDS * sizeof(scan_status_record_t));
+static uint16_t scheduler_status_sequence = 0u;
+
+/* Set by the WDT interrupt at the end of each idle period */
+static volatile bool scheduler_wake = false;
+
+/* WDT count at the last tick update */
+static uint32_t scheduler_tick = 0u;
+
+/* Totals since the last status record */
+static uint32_t scheduler_awake_ticks = 0u;
+static uint32_t scheduler_sleep_ticks = 0u;
+static uint32_t scheduler_scans = 0u;
+
+/* Timestamp of the idle scan that detected a touch */
+static bool scheduler_waking = false;
+static uint32_t scheduler_wake_start = 0u;
+
+static cy_stc_syspm_callback_params_t scheduler_capsense_pm_params =
+{
+    .base = CYBSP_CSD_HW,
+    .context = &cy_capsense_context,
+};
+
+/* Keeps the device out of Deep Sleep while a scan is in progress */
+static cy_stc_syspm_callback_t scheduler_capsense_pm_callback =
+{
+    .callback = Cy_CapSense_DeepSleepCallback,
+    .type = CY_SYSPM_DEEPSLEEP,
+    .skipMode = 0u,
+    .callbackParams = &scheduler_capsense_pm_params,
+    .prevItm = NULL,
+    .nextItm = NULL,
+};
+#endif
+
+
+#if (0u != SCAN_LOW_POWER_EN)
+/*******************************************************************************
+ * Function Name: scan_scheduler_wdt_isr
+ ********************************************************************************
+ * Summary:
+ *  WDT match interrupt: moves the match one idle period ahead, which also
+ *  keeps the WDT from resetting the device, and wakes the idle wait.
+ *
+ *******************************************************************************/
+static void scan_scheduler_wdt_isr(void)
+{
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_SetMatch((Cy_WDT_GetMatch() + SCAN_WDT_PERIOD_TICKS) & SCAN_WDT_COUNTER_MASK);
+    scheduler_wake = true;
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_ticks
+ ********************************************************************************
+ * Summary:
+ *  Returns the WDT ticks since the previous call.
+ *
+ *******************************************************************************/
+static uint32_t scan_scheduler_ticks(void)
+{
+    uint32_t now = Cy_WDT_GetCount();
+    uint32_t ticks = (now - scheduler_tick) & SCAN_WDT_COUNTER_MASK;
+
+    scheduler_tick = now;
+    return ticks;
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_status_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the status up-buffer. SEGGER_RTT_Init() must have been called
+ *  before.
+ *
+ *******************************************************************************/
+void scan_scheduler_status_init(void)
+{
+    RTT_CHANNEL_CONFIG_UP(SCAN_STATUS_RTT_CHANNEL, "power", scheduler_status_buf, RTT_CHANNEL_RECORD_FLAGS);
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_status
+ ********************************************************************************
+ * Summary:
+ *  Writes a status record with the totals since the previous record and
+ *  restarts them. The record is dropped if the up-buffer is full, which the
+ *  host detects from the sequence number.
+ *
+ * Parameters:
+ *  wake_latency: CPU cycles to return to full-rate scanning, or 0
+ *
+ *******************************************************************************/
+static void scan_scheduler_status(uint32_t wake_latency)
+{
+    scan_status_record_t record;
+
+    record.sync = SCAN_STATUS_SYNC;
+    record.state = (uint8_t)scheduler_state;
+    record.sequence = scheduler_status_sequence++;
+    record.awake_ticks = scheduler_awake_ticks;
+    record.sleep_ticks = scheduler_sleep_ticks;
+    record.scans = scheduler_scans;
+    record.wake_latency = wake_latency;
+
+    RTT_CHANNEL_WRITE(SCAN_STATUS_RTT_CHANNEL, &record, sizeof(record));
+
+    scheduler_awake_ticks = 0u;
+    scheduler_sleep_ticks = 0u;
+    scheduler_scans = 0u;
+}
+#endif
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_init
+ ********************************************************************************
+ * Summary:
+ *  Starts in full-rate scanning. timestamp_init() must have been called before.
+ *
+ *******************************************************************************/
+void scan_scheduler_init(void)
+{
+    uint32_t cycles_per_ms = SystemCoreClock / 1000u;
+#if (0u != SCAN_LOW_POWER_EN)
+    static const cy_stc_sysint_t wdt_interrupt_config =
+    {
+        .intrSrc = srss_interrupt_wdt_IRQn,
+        .intrPriority = SCAN_WDT_INTR_PRIORITY,
+    };
+#endif
+
+    scheduler_timeout_cycles = cycles_per_ms * SCAN_IDLE_TIMEOUT_MS;
+    scheduler_period_cycles = cycles_per_ms * SCAN_IDLE_PERIOD_MS;
+
+    scheduler_state = SCAN_SCHEDULER_ACTIVE;
+    scheduler_last_touch = timestamp_get();
+
+#if (0u != SCAN_LOW_POWER_EN)
+    (void)Cy_SysPm_RegisterCallback(&scheduler_capsense_pm_callback);
+
+    /* The WDT runs in all states, its interrupt keeps it from resetting the
+     * device and measures the time in Deep Sleep
+     */
+    Cy_SysInt_Init(&wdt_interrupt_config, scan_scheduler_wdt_isr);
+    NVIC_ClearPendingIRQ(wdt_interrupt_config.intrSrc);
+    NVIC_EnableIRQ(wdt_interrupt_config.intrSrc);
+
+    Cy_WDT_SetMatch((Cy_WDT_GetCount() + SCAN_WDT_PERIOD_TICKS) & SCAN_WDT_COUNTER_MASK);
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_UnmaskInterrupt();
+    Cy_WDT_Enable();
+
+    scheduler_tick = Cy_WDT_GetCount();
+#endif
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_wait
+ ********************************************************************************
+ * Summary:
+ *  When idle, waits until SCAN_IDLE_PERIOD_MS has elapsed since the start of
+ *  the previous scan, with SCAN_LOW_POWER_EN in Deep Sleep until the next
+ *  WDT match. Returns immediately when scanning at full rate.
+ *
+ *******************************************************************************/
+void scan_scheduler_wait(void)
+{
+    if (SCAN_SCHEDULER_IDLE == scheduler_state)
+    {
+#if (0u != SCAN_LOW_POWER_EN)
+        scheduler_awake_ticks += scan_scheduler_ticks();
+
+        /* Interrupts are masked around the flag check as in
+         * capsense_wait_for_scan(); other interrupts, such as the SysTick
+         * wrap, return to Deep Sleep
+         */
+        __disable_irq();
+        while (!scheduler_wake)
+        {
+            (void)Cy_SysPm_CpuEnterDeepSleep();
+
+            /* Let the pending interrupt run, then check again */
+            __enable_irq();
+            __disable_irq();
+        }
+        scheduler_wake = false;
+        __enable_irq();
+
+        scheduler_sleep_ticks += scan_scheduler_ticks();
+#else
+        while ((timestamp_get() - scheduler_last_scan) < scheduler_period_cycles)
+        {
+        }
+#endif
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_scan
+ ********************************************************************************
+ * Summary:
+ *  Starts the next scan: all widgets at full rate, otherwise the next widget
+ *  of the round-robin.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void scan_scheduler_scan(cy_stc_capsense_context_t * context)
+{
+    scheduler_last_scan = timestamp_get();
+
+    if (SCAN_SCHEDULER_ACTIVE == scheduler_state)
+    {
+        Cy_CapSense_ScanAllWidgets(context);
+    }
+    else
+    {
+        Cy_CapSense_ScanWidget(scheduler_widget, context);
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_process
+ ********************************************************************************
+ * Summary:
+ *  Processes the widgets of the completed scan and selects the next scan mode.
+ *  A touch detected on the idle widget restores full-rate scanning at once,
+ *  with SCAN_LOW_POWER_EN also a command from the tuner host. In low-power
+ *  mode, writes a status record on each change of the state and every
+ *  SCAN_STATUS_PERIOD_MS.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void scan_scheduler_process(cy_stc_capsense_context_t * context)
+{
+    uint32_t now;
+    bool touched;
+#if (0u != SCAN_LOW_POWER_EN)
+    scan_scheduler_state_t previous = scheduler_state;
+    uint32_t wake_latency = 0u;
+
+    scheduler_awake_ticks += scan_scheduler_ticks();
+    scheduler_scans++;
+#endif
+
+    if (SCAN_SCHEDULER_ACTIVE == scheduler_state)
+    {
+        Cy_CapSense_ProcessAllWidgets(context);
+
+        now = timestamp_get();
+#if (0u != SCAN_LOW_POWER_EN)
+        if (scheduler_waking)
+        {
+            /* First full-rate scan after the touch */
+            wake_latency = now - scheduler_wake_start;
+            scheduler_waking = false;
+        }
+#endif
+        if (0u != Cy_CapSense_IsAnyWidgetActive(context))
+        {
+            scheduler_last_touch = now;
+        }
+        else if ((now - scheduler_last_touch) >= scheduler_timeout_cycles)
+        {
+            scheduler_state = SCAN_SCHEDULER_IDLE;
+            scheduler_widget = (SCAN_WAKE_ROUND_ROBIN == SCAN_WAKE_WIDGET) ? 0u : SCAN_WAKE_WIDGET;
+#if (0u != SCAN_LOW_POWER_EN)
+            /* The WDT interrupt set the flag at full rate as well, so the
+             * first idle period starts now
+             */
+            __disable_irq();
+            Cy_WDT_SetMatch((Cy_WDT_GetCount() + SCAN_WDT_PERIOD_TICKS) & SCAN_WDT_COUNTER_MASK);
+            Cy_WDT_ClearInterrupt();
+            NVIC_ClearPendingIRQ(srss_interrupt_wdt_IRQn);
+            scheduler_wake = false;
+            __enable_irq();
+#endif
+            DEFERRED_LOG0("No touch, idle scanning");
+        }
+        else
+        {
+            /* Not touched, timeout still running */
+        }
+    }
+    else
+    {
+        Cy_CapSense_ProcessWidget(scheduler_widget, context);
+
+        touched = (0u != Cy_CapSense_IsWidgetActive(scheduler_widget, context));
+#if (0u != SCAN_LOW_POWER_EN)
+        /* The tuner is paused when idle, its commands wake it */
+        touched = touched || rtt_tuner_command_pending();
+#endif
+        if (touched)
+        {
+            scheduler_state = SCAN_SCHEDULER_ACTIVE;
+            scheduler_last_touch = timestamp_get();
+#if (0u != SCAN_LOW_POWER_EN)
+            scheduler_waking = true;
+            scheduler_wake_start = scheduler_last_touch;
+#endif
+            DEFERRED_LOG1("Widget %u touched, full-rate scanning", scheduler_widget);
+        }
+        else if (SCAN_WAKE_ROUND_ROBIN == SCAN_WAKE_WIDGET)
+        {
+            scheduler_widget = (scheduler_widget + 1u) % CY_CAPSENSE_WIDGET_COUNT;
+        }
+        else
+        {
+            /* Only the wake widget is scanned when idle */
+        }
+    }
+
+#if (0u != SCAN_LOW_POWER_EN)
+    /* Waking is reported with the first full-rate scan, to include its latency */
+    if (((previous != scheduler_state) && !scheduler_waking) || (0u != wake_latency) ||
+        ((scheduler_awake_ticks + scheduler_sleep_ticks) >= SCAN_STATUS_PERIOD_TICKS))
+    {
+        scan_scheduler_status(wake_latency);
+    }
+#endif
+}
+
+
+/*******************************************************************************
+ * Function Name: scan_scheduler_idle
+ ********************************************************************************
+ * Summary:
+ *  Checks whether the scheduler scans at the idle rate.
+ *
+ * Return:
+ *  true when idle
+ *
+ *******************************************************************************/
+bool scan_scheduler_idle(void)
+{
+    return (SCAN_SCHEDULER_IDLE == scheduler_state);
+}
+#endif /* SCAN_SCHEDULER_EN */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * File Name: scan_scheduler.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the adaptive scan scheduler, which scans all widgets at full rate
+ * while the user interacts and a single widget at a time when idle.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef SCAN_SCHEDULER_H
+#define SCAN_SCHEDULER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Adaptive scanning: all widgets are scanned back to back while any widget is
+ * active. After SCAN_IDLE_TIMEOUT_MS without a touch, one widget is scanned
+ * every SCAN_IDLE_PERIOD_MS in round-robin order, or SCAN_WAKE_WIDGET only,
+ * until a touch is detected.
+ */
+#ifndef SCAN_SCHEDULER_EN
+#define SCAN_SCHEDULER_EN               (0u)
+#endif
+
+/* Timing per kit, can be overridden through the Makefile DEFINES */
+#if defined(TARGET_CY8CKIT_145_40XX)
+/* Three buttons and a slider on the PSoC 4000S */
+#define SCAN_IDLE_TIMEOUT_MS_DEFAULT    (1000u)
+#define SCAN_IDLE_PERIOD_MS_DEFAULT     (25u)
+#elif defined(TARGET_CY8CKIT_045S)
+/* Only one button and the slider, each is revisited every second period */
+#define SCAN_IDLE_TIMEOUT_MS_DEFAULT    (1000u)
+#define SCAN_IDLE_PERIOD_MS_DEFAULT     (40u)
+#else
+/* CY8CKIT-149: three buttons and a slider on the PSoC 4100S Plus */
+#define SCAN_IDLE_TIMEOUT_MS_DEFAULT    (1000u)
+#define SCAN_IDLE_PERIOD_MS_DEFAULT     (20u)
+#endif
+
+/* Time without any active widget before switching to idle scanning */
+#ifndef SCAN_IDLE_TIMEOUT_MS
+#define SCAN_IDLE_TIMEOUT_MS            SCAN_IDLE_TIMEOUT_MS_DEFAULT
+#endif
+
+/* Time between the start of two single-widget scans when idle */
+#ifndef SCAN_IDLE_PERIOD_MS
+#define SCAN_IDLE_PERIOD_MS             SCAN_IDLE_PERIOD_MS_DEFAULT
+#endif
+
+/* Low-power idle: the CPU waits for the next idle scan in Deep Sleep, woken by
+ * the WDT, the tuner pauses, and the scheduler reports its state and duty
+ * cycle as status records on SCAN_STATUS_RTT_CHANNEL.
+ */
+#ifndef SCAN_LOW_POWER_EN
+#define SCAN_LOW_POWER_EN               (0u)
+#endif
+
+/* Widget scanned when idle, for example a proximity widget that gangs all
+ * sensors. By default, all widgets are scanned in round-robin order.
+ */
+#define SCAN_WAKE_ROUND_ROBIN           (0xFFu)
+
+#ifndef SCAN_WAKE_WIDGET
+#define SCAN_WAKE_WIDGET                SCAN_WAKE_ROUND_ROBIN
+#endif
+
+/* Time between two status records while the state does not change */
+#ifndef SCAN_STATUS_PERIOD_MS
+#define SCAN_STATUS_PERIOD_MS           (1000u)
+#endif
+
+/* Nominal ILO frequency that clocks the WDT */
+#ifndef SCAN_ILO_HZ
+#define SCAN_ILO_HZ                     (40000u)
+#endif
+
+#ifndef SCAN_WDT_INTR_PRIORITY
+#define SCAN_WDT_INTR_PRIORITY          (3u)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    SCAN_SCHEDULER_ACTIVE,  /* All widgets, back to back */
+    SCAN_SCHEDULER_IDLE     /* One widget per SCAN_IDLE_PERIOD_MS */
+} scan_scheduler_state_t;
+
+/* Status record, all fields are little-endian. Written on each change of the
+ * state and every SCAN_STATUS_PERIOD_MS.
+ */
+typedef struct
+{
+    uint8_t  sync;          /* SCAN_STATUS_SYNC */
+    uint8_t  state;         /* scan_scheduler_state_t */
+    uint16_t sequence;      /* Incremented per record */
+    uint32_t awake_ticks;   /* ILO ticks awake since the previous record */
+    uint32_t sleep_ticks;   /* ILO ticks in Deep Sleep since the previous record */
+    uint32_t scans;         /* Scans since the previous record */
+    uint32_t wake_latency;  /* CPU cycles from the idle scan that detected a
+                             * touch to the end of the first full-rate scan,
+                             * on the first record after waking, otherwise 0 */
+} scan_status_record_t;
+
+#define SCAN_STATUS_SYNC                (0xA5u)
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != SCAN_SCHEDULER_EN)
+void scan_scheduler_init(void);
+void scan_scheduler_wait(void);
+void scan_scheduler_scan(cy_stc_capsense_context_t * context);
+void scan_scheduler_process(cy_stc_capsense_context_t * context);
+bool scan_scheduler_idle(void);
+#if (0u != SCAN_LOW_POWER_EN)
+void scan_scheduler_status_init(void);
+#endif
+#endif
+
+#endif /* SCAN_SCHEDULER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,276 @@
+/******************************************************************************
+ * File Name: signal_stats.c
+ *
+ * Description: This file contains the signal statistics. After each scan
+ * cycle, every sensor updates a running mean and variance of its raw count
+ * with Welford's method while not touched, and its difference count range
+ * and touch signal. At the end of an interval, a summary record is written
+ * to an RTT up-buffer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "signal_stats.h"
+
+#if (0u != SIGNAL_STATS_EN)
+#include "timestamp.h"
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* The touch signal is summed in 32 bits */
+#if (SIGNAL_STATS_INTERVAL < 2u) || (SIGNAL_STATS_INTERVAL > 65536u)
+#error "SIGNAL_STATS_INTERVAL must be from 2 to 65536"
+#endif
+
+/* The running mean has 8 fractional bits, the sum of squares 16 */
+#define SIGNAL_STATS_MEAN_SHIFT         (8u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t noise_count;   /* Samples while not touched */
+    int32_t  mean;          /* Running mean of the raw count */
+    uint64_t m2;            /* Sum of squared deviations from the mean */
+    uint32_t signal_count;  /* Samples while touched */
+    uint32_t signal_sum;
+    uint16_t diff_min;
+    uint16_t diff_max;
+    uint16_t bsln_start;
+} signal_stats_acc_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+RTT_CHANNEL_BUFFER(signal_stats_up_buf, SIGNAL_STATS_BUF_RECORDS * sizeof(signal_stats_record_t));
+
+static signal_stats_acc_t signal_stats_acc[CY_CAPSENSE_SENSOR_COUNT];
+static signal_stats_record_t signal_stats_record;
+static uint32_t signal_stats_count = 0u;
+static uint16_t signal_stats_sequence = 0u;
+
+
+/*******************************************************************************
+ * Function Name: signal_stats_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the signal statistics up-buffer. SEGGER_RTT_Init() must have
+ *  been called before.
+ *
+ *******************************************************************************/
+void signal_stats_init(void)
+{
+    RTT_CHANNEL_CONFIG_UP(SIGNAL_STATS_RTT_CHANNEL, "stats", signal_stats_up_buf, RTT_CHANNEL_RECORD_FLAGS);
+}
+
+
+/*******************************************************************************
+ * Function Name: signal_stats_sqrt
+ ********************************************************************************
+ * Summary:
+ *  Calculates the integer square root, bit by bit without divisions.
+ *
+ * Parameters:
+ *  value: radicand
+ *
+ * Return:
+ *  Largest integer whose square is not greater than value
+ *
+ *******************************************************************************/
+static uint32_t signal_stats_sqrt(uint32_t value)
+{
+    uint32_t root = 0u;
+    uint32_t bit = 1uL << 30u;
+
+    while (bit > value)
+    {
+        bit >>= 2u;
+    }
+
+    while (0u != bit)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1u) + bit;
+        }
+        else
+        {
+            root >>= 1u;
+        }
+        bit >>= 2u;
+    }
+
+    return root;
+}
+
+
+/*******************************************************************************
+ * Function Name: signal_stats_summarize
+ ********************************************************************************
+ * Summary:
+ *  Calculates the summary of one sensor from its running statistics.
+ *
+ * Parameters:
+ *  entry: summary to fill
+ *  acc: running statistics of the interval
+ *  bsln: current baseline
+ *
+ *******************************************************************************/
+static void signal_stats_summarize(signal_stats_entry_t * entry, const signal_stats_acc_t * acc, uint16_t bsln)
+{
+    uint64_t variance;
+    uint32_t noise = 0u;
+    uint32_t signal = 0u;
+    uint32_t snr = 0u;
+
+    if (acc->noise_count > 1u)
+    {
+        /* Sample variance with 16 fractional bits, its root has 8 */
+        variance = acc->m2 / (acc->noise_count - 1u);
+        noise = (variance > 0xFFFFFFFFu) ? 0xFFFFu : (signal_stats_sqrt((uint32_t)variance) >> 4u);
+    }
+
+    if (0u != acc->signal_count)
+    {
+        signal = acc->signal_sum / acc->signal_count;
+        snr = (0u != noise) ? ((signal << 8u) / noise) : 0xFFFFu;
+    }
+
+    entry->noise = (uint16_t)noise;
+    entry->signal = (uint16_t)signal;
+    entry->snr = (snr > 0xFFFFu) ? 0xFFFFu : (uint16_t)snr;
+    entry->diff_min = acc->diff_min;
+    entry->diff_max = acc->diff_max;
+    entry->drift = (int16_t)((int32_t)bsln - (int32_t)acc->bsln_start);
+}
+
+
+/*******************************************************************************
+ * Function Name: signal_stats_update
+ ********************************************************************************
+ * Summary:
+ *  Updates the running statistics of every sensor. Call once per scan cycle
+ *  after all widgets are processed. The raw count of a sensor that is not
+ *  touched updates its noise estimate with one Welford step; the difference
+ *  count of a touched sensor adds to its signal. At the end of an interval,
+ *  writes the summary record and starts the next interval. The record is
+ *  dropped if the up-buffer is full, which the host detects from the
+ *  sequence number.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void signal_stats_update(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_sensor_context_t * sensor = context->ptrWdConfig[0u].ptrSnsContext;
+    signal_stats_acc_t * acc = signal_stats_acc;
+    int32_t value;
+    int32_t delta;
+    uint32_t i;
+
+    for (i = 0u; i < CY_CAPSENSE_SENSOR_COUNT; i++)
+    {
+        if (0u == signal_stats_count)
+        {
+            acc->noise_count = 0u;
+            acc->mean = 0;
+            acc->m2 = 0u;
+            acc->signal_count = 0u;
+            acc->signal_sum = 0u;
+            acc->diff_min = sensor->diff;
+            acc->diff_max = sensor->diff;
+            acc->bsln_start = sensor->bsln;
+        }
+
+        if (sensor->diff < acc->diff_min)
+        {
+            acc->diff_min = sensor->diff;
+        }
+        if (sensor->diff > acc->diff_max)
+        {
+            acc->diff_max = sensor->diff;
+        }
+
+        if (0u != (sensor->status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK))
+        {
+            acc->signal_count++;
+            acc->signal_sum += sensor->diff;
+        }
+        else
+        {
+            /* mean += (x - mean) / n, m2 += (x - mean_old) * (x - mean_new) */
+            value = (int32_t)((uint32_t)sensor->raw << SIGNAL_STATS_MEAN_SHIFT);
+            acc->noise_count++;
+            delta = value - acc->mean;
+            acc->mean += delta / (int32_t)acc->noise_count;
+            acc->m2 += (uint64_t)((int64_t)delta * (value - acc->mean));
+        }
+
+        sensor++;
+        acc++;
+    }
+
+    signal_stats_count++;
+    if (SIGNAL_STATS_INTERVAL == signal_stats_count)
+    {
+        signal_stats_count = 0u;
+
+        sensor = context->ptrWdConfig[0u].ptrSnsContext;
+        signal_stats_record.sequence = signal_stats_sequence++;
+        signal_stats_record.sensors = (uint8_t)CY_CAPSENSE_SENSOR_COUNT;
+        signal_stats_record.reserved = 0u;
+        signal_stats_record.scans = SIGNAL_STATS_INTERVAL;
+        signal_stats_record.time = timestamp_get();
+        for (i = 0u; i < CY_CAPSENSE_SENSOR_COUNT; i++)
+        {
+            signal_stats_summarize(&signal_stats_record.entry[i], &signal_stats_acc[i], sensor[i].bsln);
+        }
+
+        RTT_CHANNEL_WRITE(SIGNAL_STATS_RTT_CHANNEL, &signal_stats_record, sizeof(signal_stats_record));
+    }
+}
+#endif /* SIGNAL_STATS_EN */
+
+
+/* [] END OF FILE */
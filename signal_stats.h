@@ -0,0 +1,107 @@
+/******************************************************************************
+ * File Name: signal_stats.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the signal statistics, which track the noise, signal, SNR and baseline
+ * drift of every sensor on target and report a summary over RTT.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef SIGNAL_STATS_H
+#define SIGNAL_STATS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Track signal statistics of every sensor */
+#ifndef SIGNAL_STATS_EN
+#define SIGNAL_STATS_EN                 (0u)
+#endif
+
+/* Number of scans per summary record */
+#ifndef SIGNAL_STATS_INTERVAL
+#define SIGNAL_STATS_INTERVAL           (1024u)
+#endif
+
+/* Number of records the up-buffer holds */
+#ifndef SIGNAL_STATS_BUF_RECORDS
+#define SIGNAL_STATS_BUF_RECORDS        (2u)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Statistics of one sensor over an interval */
+typedef struct
+{
+    uint16_t noise;         /* RMS raw count noise while not touched, 1/16 counts */
+    uint16_t signal;        /* Mean difference count while touched */
+    uint16_t snr;           /* signal / noise, 1/16 steps, 0 without touch */
+    uint16_t diff_min;      /* Smallest difference count */
+    uint16_t diff_max;      /* Largest difference count */
+    int16_t  drift;         /* Baseline change over the interval */
+} signal_stats_entry_t;
+
+/* Summary record of one interval, all fields are little-endian */
+typedef struct
+{
+    uint16_t sequence;      /* Incremented per interval */
+    uint8_t  sensors;       /* CY_CAPSENSE_SENSOR_COUNT */
+    uint8_t  reserved;
+    uint32_t scans;         /* SIGNAL_STATS_INTERVAL */
+    uint32_t time;          /* CPU cycle timestamp at the end of the interval */
+    signal_stats_entry_t entry[CY_CAPSENSE_SENSOR_COUNT];
+} signal_stats_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != SIGNAL_STATS_EN)
+void signal_stats_init(void);
+void signal_stats_update(const cy_stc_capsense_context_t * context);
+#endif
+
+#endif /* SIGNAL_STATS_H */
+
+
+/* [] END OF FILE */
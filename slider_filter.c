@@ -0,0 +1,279 @@
+/******************************************************************************
+ * File Name: slider_filter.c
+ *
+ * Description: This file contains the slider position filter. Each stage
+ * works on 1/256 position steps with shifts, additions and compares only,
+ * as the Cortex-M0+ has no hardware divider.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "slider_filter.h"
+
+#if (0u != SLIDER_FILTER_EN)
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#if (0u == (SLIDER_FILTER_STAGES & (SLIDER_FILTER_MEDIAN | SLIDER_FILTER_IIR | SLIDER_FILTER_JITTER)))
+#error "SLIDER_FILTER_STAGES selects no filter stage"
+#endif
+
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_PREDICT)) && (0u == (SLIDER_FILTER_STAGES & SLIDER_FILTER_IIR))
+#error "SLIDER_FILTER_PREDICT requires SLIDER_FILTER_IIR"
+#endif
+
+#if (0u == SLIDER_FILTER_IIR_SHIFT) || (SLIDER_FILTER_IIR_SHIFT > 8u)
+#error "SLIDER_FILTER_IIR_SHIFT must be 1 to 8"
+#endif
+
+/* Fractional bits of the filter state, at least SLIDER_FILTER_IIR_SHIFT so
+ * that the truncated IIR step settles within one position step
+ */
+#define SLIDER_FILTER_FRAC_BITS         (8u)
+#define SLIDER_FILTER_HALF              (1L << (SLIDER_FILTER_FRAC_BITS - 1u))
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    bool     active;        /* Touched at the previous update */
+    uint16_t position;      /* Filtered position */
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_MEDIAN))
+    uint16_t history[2u];   /* Previous two input positions */
+#endif
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_IIR))
+    int32_t  iir;           /* IIR output, 1/256 steps */
+#endif
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_PREDICT))
+    int32_t  velocity;      /* Smoothed IIR output change per scan, 1/256 steps */
+#endif
+} slider_filter_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static slider_filter_state_t slider_filter_state[CY_CAPSENSE_WIDGET_COUNT];
+
+
+/*******************************************************************************
+ * Function Name: slider_filter_reset
+ ********************************************************************************
+ * Summary:
+ *  Starts all stages at the first position of a touch, so that the filter
+ *  does not slide in from the previous touch.
+ *
+ * Parameters:
+ *  state: filter state of the slider
+ *  position: first position of the touch
+ *
+ *******************************************************************************/
+static void slider_filter_reset(slider_filter_state_t * state, uint16_t position)
+{
+    state->position = position;
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_MEDIAN))
+    state->history[0u] = position;
+    state->history[1u] = position;
+#endif
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_IIR))
+    state->iir = (int32_t)position << SLIDER_FILTER_FRAC_BITS;
+#endif
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_PREDICT))
+    state->velocity = 0;
+#endif
+}
+
+
+/*******************************************************************************
+ * Function Name: slider_filter_run
+ ********************************************************************************
+ * Summary:
+ *  Passes one position through the selected stages.
+ *
+ * Parameters:
+ *  state: filter state of the slider
+ *  position: position reported by the middleware
+ *  max_position: largest position of the slider
+ *
+ *******************************************************************************/
+static void slider_filter_run(slider_filter_state_t * state, uint16_t position, uint16_t max_position)
+{
+    int32_t value = (int32_t)position;
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_MEDIAN))
+    uint16_t a = state->history[0u];
+    uint16_t b = state->history[1u];
+#endif
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_IIR))
+    int32_t previous;
+#endif
+
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_MEDIAN))
+    /* Median of three, a single outlier never passes */
+    state->history[0u] = b;
+    state->history[1u] = position;
+    if (a > b)
+    {
+        uint16_t swap = a;
+        a = b;
+        b = swap;
+    }
+    value = (int32_t)((position < a) ? a : ((position > b) ? b : position));
+#endif
+
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_IIR))
+    previous = state->iir;
+    state->iir += ((value << SLIDER_FILTER_FRAC_BITS) - state->iir) >> SLIDER_FILTER_IIR_SHIFT;
+    value = state->iir;
+
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_PREDICT))
+    /* On a steady slide, the IIR output lags the input by
+     * (2^SHIFT - 1) times the change per scan
+     */
+    state->velocity += ((state->iir - previous) - state->velocity) >> SLIDER_FILTER_IIR_SHIFT;
+    value += (state->velocity << SLIDER_FILTER_IIR_SHIFT) - state->velocity;
+#else
+    (void)previous;
+#endif
+
+    value = (value + SLIDER_FILTER_HALF) >> SLIDER_FILTER_FRAC_BITS;
+#endif
+
+    if (value < 0)
+    {
+        value = 0;
+    }
+    else if (value > (int32_t)max_position)
+    {
+        value = (int32_t)max_position;
+    }
+    else
+    {
+        /* In range */
+    }
+
+#if (0u != (SLIDER_FILTER_STAGES & SLIDER_FILTER_JITTER))
+    /* Follow the input only once it leaves the dead band */
+    if (value > ((int32_t)state->position + (int32_t)SLIDER_FILTER_JITTER_TH))
+    {
+        value -= (int32_t)SLIDER_FILTER_JITTER_TH;
+    }
+    else if (value < ((int32_t)state->position - (int32_t)SLIDER_FILTER_JITTER_TH))
+    {
+        value += (int32_t)SLIDER_FILTER_JITTER_TH;
+    }
+    else
+    {
+        value = (int32_t)state->position;
+    }
+#endif
+
+    state->position = (uint16_t)value;
+}
+
+
+/*******************************************************************************
+ * Function Name: slider_filter_update
+ ********************************************************************************
+ * Summary:
+ *  Filters the first touch position of every linear slider. Call once per
+ *  scan cycle after all widgets are processed. While a slider is not
+ *  touched, its last filtered position is kept.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void slider_filter_update(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t * config;
+    const cy_stc_capsense_touch_t * touch;
+    slider_filter_state_t * state;
+    uint32_t widget_id;
+    bool active;
+
+    for (widget_id = 0u; widget_id < CY_CAPSENSE_WIDGET_COUNT; widget_id++)
+    {
+        config = &context->ptrWdConfig[widget_id];
+        if (CY_CAPSENSE_WD_LINEAR_SLIDER_E != config->wdType)
+        {
+            continue;
+        }
+
+        state = &slider_filter_state[widget_id];
+        touch = Cy_CapSense_GetTouchInfo(widget_id, context);
+        active = (0u != Cy_CapSense_IsWidgetActive(widget_id, context)) && (0u != touch->numPosition);
+
+        if (active)
+        {
+            if (!state->active)
+            {
+                slider_filter_reset(state, touch->ptrPosition[0u].x);
+            }
+            else
+            {
+                slider_filter_run(state, touch->ptrPosition[0u].x, config->xResolution);
+            }
+        }
+        state->active = active;
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: slider_filter_get_position
+ ********************************************************************************
+ * Summary:
+ *  Returns the filtered position of a linear slider.
+ *
+ * Parameters:
+ *  widget_id: widget index of the slider
+ *
+ * Return:
+ *  Filtered position, the last one after a release
+ *
+ *******************************************************************************/
+uint16_t slider_filter_get_position(uint32_t widget_id)
+{
+    return slider_filter_state[widget_id].position;
+}
+#endif /* SLIDER_FILTER_EN */
+
+
+/* [] END OF FILE */
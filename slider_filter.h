@@ -0,0 +1,92 @@
+/******************************************************************************
+ * File Name: slider_filter.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the slider position filter, a fixed-point post-processing stage for the
+ * positions of the linear sliders.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef SLIDER_FILTER_H
+#define SLIDER_FILTER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Filter the positions of the linear sliders after processing */
+#ifndef SLIDER_FILTER_EN
+#define SLIDER_FILTER_EN                (0u)
+#endif
+
+/* Filter stages, applied in this order */
+#define SLIDER_FILTER_MEDIAN            (0x01u)     /* Median of the last three positions */
+#define SLIDER_FILTER_IIR               (0x02u)     /* First-order IIR low-pass */
+#define SLIDER_FILTER_PREDICT           (0x04u)     /* Compensates the IIR lag from the velocity */
+#define SLIDER_FILTER_JITTER            (0x08u)     /* Dead band around the reported position */
+
+#ifndef SLIDER_FILTER_STAGES
+#define SLIDER_FILTER_STAGES            (SLIDER_FILTER_IIR | SLIDER_FILTER_JITTER)
+#endif
+
+/* IIR coefficient 1 / 2^SHIFT */
+#ifndef SLIDER_FILTER_IIR_SHIFT
+#define SLIDER_FILTER_IIR_SHIFT         (2u)
+#endif
+
+/* Changes up to this number of position steps are not reported */
+#ifndef SLIDER_FILTER_JITTER_TH
+#define SLIDER_FILTER_JITTER_TH         (1u)
+#endif
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != SLIDER_FILTER_EN)
+void slider_filter_update(const cy_stc_capsense_context_t * context);
+uint16_t slider_filter_get_position(uint32_t widget_id);
+#endif
+
+#endif /* SLIDER_FILTER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * File Name: timestamp.c
+ *
+ * Description: This file implements a 32-bit CPU cycle timestamp based
+ * on the SysTick timer. The timestamp wraps every 2^32 CPU cycles, hosts and
+ * callers compute differences with unsigned arithmetic.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "timestamp.h"
+#include "profiler.h"
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static volatile uint32_t timestamp_wraps = 0u;
+
+
+/*******************************************************************************
+ * Function Name: timestamp_init
+ ********************************************************************************
+ * Summary:
+ *  Starts SysTick from the CPU clock with the maximum reload value and enables
+ *  its interrupt to extend the counter to 32 bits.
+ *
+ *******************************************************************************/
+void timestamp_init(void)
+{
+    timestamp_wraps = 0u;
+
+    SysTick->LOAD = TIMESTAMP_SYSTICK_RELOAD;
+    SysTick->VAL  = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |
+                    SysTick_CTRL_TICKINT_Msk   |
+                    SysTick_CTRL_ENABLE_Msk;
+}
+
+
+/*******************************************************************************
+ * Function Name: timestamp_get
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of CPU cycles since timestamp_init(), modulo 2^32.
+ *  Safe to call with interrupts disabled: a wrap that is pending but not yet
+ *  serviced is accounted for here.
+ *
+ * Return:
+ *  uint32_t: timestamp in CPU clock cycles
+ *
+ *******************************************************************************/
+uint32_t timestamp_get(void)
+{
+    uint32_t interrupt_state;
+    uint32_t wraps;
+    uint32_t count;
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    count = SysTick->VAL;
+    wraps = timestamp_wraps;
+    if (0u != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+    {
+        /* Counter wrapped and SysTick_Handler did not run yet. Re-read the
+         * counter so that it is consistent with the incremented wrap count.
+         */
+        count = SysTick->VAL;
+        wraps++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return (wraps << TIMESTAMP_SYSTICK_BITS) + (TIMESTAMP_SYSTICK_RELOAD - count);
+}
+
+
+/*******************************************************************************
+ * Function Name: SysTick_Handler
+ ********************************************************************************
+ * Summary:
+ *  Counts SysTick wraps for timestamp_get(). With the profiler compiled in,
+ *  also samples the interrupt entry latency: the counter reloaded at the wrap,
+ *  so the cycles it has counted since then are the time to enter this handler.
+ *
+ *******************************************************************************/
+void SysTick_Handler(void)
+{
+    timestamp_wraps++;
+
+#if (0u != PROFILER_EN)
+    profiler_record(PROFILER_STAGE_IRQ_LATENCY, TIMESTAMP_SYSTICK_RELOAD - SysTick->VAL);
+#endif
+}
+
+
+/* [] END OF FILE */
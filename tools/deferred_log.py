@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""Host decoder for the deferred logger.
+
+The firmware (DEFERRED_LOG_EN=1u) writes every log as a binary record to its
+RTT up-buffer: a header word, the CPU cycle timestamp and up to four raw
+argument words. The format strings never reach the target flash; they are
+kept in the non-loaded .deferred_log section of the ELF file, together with
+the header of their record and the source file name. This script reads the
+records over J-Link, or from a file captured with another RTT client, and
+formats them.
+
+Record header: bits 31:29 argument count, 28:16 module, 15:0 line. All
+words are little-endian. Module 0x1FFF reports the number of records that
+were dropped because the up-buffer was full.
+
+Requires pyelftools, and pylink-square when reading over J-Link.
+
+Example:
+    tools/deferred_log.py --device CY8C4147AZI-S475 --core-clock-hz 48000000
+"""
+
+import argparse
+import glob
+import os
+import re
+import struct
+import sys
+import time
+
+LOG_CHANNEL = 4
+
+NARGS_POS = 29
+MODULE_POS = 16
+MODULE_MASK = 0x1FFF
+MODULE_DROPPED = MODULE_MASK
+
+REPO_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# printf conversion: flags, width, precision, length modifier, conversion
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+
+class Elf:
+    """Format records and constant strings of the firmware ELF file."""
+
+    def __init__(self, path):
+        from elftools.elf.elffile import ELFFile
+
+        self.formats = {}
+        self.segments = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            section = elf.get_section_by_name(".deferred_log")
+            if section is None:
+                sys.exit("%s: no .deferred_log section, build with DEFERRED_LOG_EN=1u" % path)
+            self._parse_formats(section.data())
+            for section in elf.iter_sections():
+                if section["sh_flags"] & 0x2 and section["sh_type"] == "SHT_PROGBITS":
+                    self.segments.append((section["sh_addr"], section.data()))
+
+    def _parse_formats(self, data):
+        offset = 0
+        while offset + 4 <= len(data):
+            header, = struct.unpack_from("<I", data, offset)
+            end = data.index(b"\0", offset + 4)
+            fmt = data[offset + 4:end].decode("utf-8", "replace")
+            file_end = data.index(b"\0", end + 1)
+            file = data[end + 1:file_end].decode("utf-8", "replace")
+            offset = (file_end + 4) & ~3
+            if header in self.formats and self.formats[header] != (fmt, file):
+                print("warning: %s and %s share the record header 0x%08X; "
+                      "use one log per line and a unique DEFERRED_LOG_MODULE per file"
+                      % (self.formats[header][1], file, header), file=sys.stderr)
+            self.formats[header] = (fmt, file)
+
+    def string(self, address):
+        for start, data in self.segments:
+            if start <= address < start + len(data):
+                end = data.find(b"\0", address - start)
+                if end < 0:
+                    end = len(data)
+                return data[address - start:end].decode("utf-8", "replace")
+        return "<0x%08X>" % address
+
+
+def format_message(fmt, args, elf):
+    """Formats a printf-style string with 32-bit argument words."""
+    words = iter(args)
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        value = next(words, 0)
+        spec = "%" + flags + width + ("." + precision if precision else "")
+        if conv in "di":
+            if value & 0x80000000:
+                value -= 1 << 32
+            return (spec + "d") % value
+        if conv == "s":
+            return (spec + "s") % elf.string(value)
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv == "p":
+            return "0x%08X" % value
+        return (spec + conv) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class RecordParser:
+    """Splits the log byte stream into records."""
+
+    def __init__(self):
+        self.buffer = b""
+
+    def feed(self, data):
+        self.buffer += data
+        records = []
+        while len(self.buffer) >= 8:
+            header, timestamp = struct.unpack_from("<II", self.buffer, 0)
+            nargs = header >> NARGS_POS
+            size = 8 + 4 * nargs
+            if len(self.buffer) < size:
+                break
+            args = struct.unpack_from("<%dI" % nargs, self.buffer, 8)
+            records.append((header, timestamp, args))
+            self.buffer = self.buffer[size:]
+        return records
+
+
+class Clock:
+    """Extends the 32-bit cycle timestamp and converts it to seconds."""
+
+    def __init__(self, core_clock_hz):
+        self.core_clock_hz = core_clock_hz
+        self.last = None
+        self.high = 0
+
+    def __call__(self, timestamp):
+        if self.last is not None and timestamp < self.last:
+            self.high += 1 << 32
+        self.last = timestamp
+        cycles = self.high + timestamp
+        if self.core_clock_hz:
+            return "%12.6f" % (cycles / self.core_clock_hz)
+        return "%12d" % cycles
+
+
+def print_records(records, elf, clock, output):
+    for header, timestamp, args in records:
+        module = (header >> MODULE_POS) & MODULE_MASK
+        if module == MODULE_DROPPED:
+            message = "*** %d records dropped" % args[0]
+            location = ""
+        elif header in elf.formats:
+            fmt, file = elf.formats[header]
+            message = format_message(fmt, args, elf)
+            location = "%s:%d" % (os.path.basename(file), header & 0xFFFF)
+        else:
+            message = "unknown record 0x%08X %s" % (header, " ".join("0x%08X" % a for a in args))
+            location = ""
+        output.write("%s  %-24s %s\n" % (clock(timestamp), location, message))
+    output.flush()
+
+
+def read_jlink(args, handle):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > LOG_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        try:
+            while True:
+                data = jlink.rtt_read(LOG_CHANNEL, 4096)
+                if data:
+                    handle(bytes(data))
+                else:
+                    time.sleep(0.01)
+        except KeyboardInterrupt:
+            pass
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+
+
+def find_elf():
+    elfs = glob.glob(os.path.join(REPO_DIR, "build", "**", "*.elf"), recursive=True)
+    if not elfs:
+        sys.exit("No ELF file found in build/, use --elf")
+    return max(elfs, key=os.path.getmtime)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--elf", help="firmware ELF file, the newest one in build/ if omitted")
+    parser.add_argument("--input", help="decode a captured binary log file instead of reading over J-Link")
+    parser.add_argument("--device", help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--core-clock-hz", type=float,
+                        help="target core clock, timestamps are printed in cycles if omitted")
+    args = parser.parse_args()
+    if not args.input and not args.device:
+        parser.error("either --input or --device is required")
+
+    elf = Elf(args.elf or find_elf())
+    records = RecordParser()
+    clock = Clock(args.core_clock_hz)
+
+    def handle(data):
+        print_records(records.feed(data), elf, clock, sys.stdout)
+
+    if args.input:
+        with open(args.input, "rb") as f:
+            handle(f.read())
+    else:
+        read_jlink(args, handle)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Host reader for the noise metrics.
+
+The firmware (NOISE_METRICS_EN=1u) measures the raw count noise of every
+sensor at every scan frequency over windows of NOISE_METRICS_WINDOW scans, and
+writes one record per window to its RTT up-buffer. This script reads the
+records over J-Link, or from a file captured with another RTT client, prints
+them as CSV, and at the end reports the mean noise of each sensor per scan
+frequency and the frequency with the lowest noise.
+
+Record layout: 16-bit sequence, 8-bit sensor count, 8-bit frequency count,
+16-bit window length, 16-bit reserved, then for each frequency and each
+sensor the 16-bit peak-to-peak noise and the 16-bit raw count variance. All
+values are little-endian.
+
+Requires pylink-square unless --input is used.
+
+Example:
+    tools/noise_metrics.py --device CY8C4147AZI-S475 --output noise.csv
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+NOISE_CHANNEL = 7
+
+HEADER_SIZE = 8
+ENTRY_SIZE = 4
+
+
+class RecordParser:
+    """Splits the byte stream into records of
+    (sequence, window, [[(peak_to_peak, variance), ...] per frequency])."""
+
+    def __init__(self):
+        self.buffer = b""
+        self.dropped = 0
+        self.last_sequence = None
+
+    def feed(self, data):
+        self.buffer += data
+        records = []
+        while len(self.buffer) >= HEADER_SIZE:
+            sequence, sensors, frequencies, window, _ = struct.unpack_from("<HBBHH", self.buffer, 0)
+            size = HEADER_SIZE + ENTRY_SIZE * sensors * frequencies
+            if len(self.buffer) < size:
+                break
+            values = struct.unpack_from("<%dH" % (2 * sensors * frequencies), self.buffer, HEADER_SIZE)
+            entries = list(zip(values[0::2], values[1::2]))
+            records.append((sequence, window,
+                            [entries[f * sensors:(f + 1) * sensors] for f in range(frequencies)]))
+            if self.last_sequence is not None:
+                self.dropped += (sequence - self.last_sequence - 1) & 0xFFFF
+            self.last_sequence = sequence
+            self.buffer = self.buffer[size:]
+        return records
+
+
+class Summary:
+    """Mean peak-to-peak noise and variance per sensor and frequency."""
+
+    def __init__(self):
+        self.windows = 0
+        self.sums = None
+
+    def add(self, record):
+        _, _, frequencies = record
+        if self.sums is None:
+            self.sums = [[[0, 0] for _ in entries] for entries in frequencies]
+        for sums, entries in zip(self.sums, frequencies):
+            for total, (peak_to_peak, variance) in zip(sums, entries):
+                total[0] += peak_to_peak
+                total[1] += variance
+        self.windows += 1
+
+    def write(self, output):
+        if not self.windows:
+            return
+        output.write("%d windows\n" % self.windows)
+        output.write("sensor  " + "  ".join("f%d p2p    var" % f for f in range(len(self.sums))) + "  best\n")
+        for sensor in range(len(self.sums[0])):
+            means = [(s[sensor][0] / self.windows, s[sensor][1] / self.windows) for s in self.sums]
+            best = min(range(len(means)), key=lambda f: means[f][1])
+            output.write("%6d  " % sensor + "  ".join("%6.1f %6.1f" % m for m in means) + "  f%d\n" % best)
+
+
+def write_csv_header(record, output):
+    _, _, frequencies = record
+    columns = ["sequence", "window"]
+    for f, entries in enumerate(frequencies):
+        for sensor in range(len(entries)):
+            columns += ["p2p%d_f%d" % (sensor, f), "var%d_f%d" % (sensor, f)]
+    output.write(",".join(columns) + "\n")
+
+
+def write_csv(records, output):
+    for sequence, window, frequencies in records:
+        values = [sequence, window]
+        for entries in frequencies:
+            for entry in entries:
+                values += entry
+        output.write(",".join(str(v) for v in values) + "\n")
+    output.flush()
+
+
+def read_jlink(args, handle):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > NOISE_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        deadline = time.monotonic() + args.duration if args.duration else None
+        try:
+            while deadline is None or time.monotonic() < deadline:
+                data = jlink.rtt_read(NOISE_CHANNEL, 4096)
+                if data:
+                    handle(bytes(data))
+                else:
+                    time.sleep(0.05)
+        except KeyboardInterrupt:
+            pass
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--device", help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--duration", type=float, help="seconds to read, until Ctrl+C if omitted")
+    parser.add_argument("--input", help="decode a captured binary file instead of reading over J-Link")
+    parser.add_argument("--output", help="CSV file, stdout if omitted")
+    args = parser.parse_args()
+    if not args.input and not args.device:
+        parser.error("either --input or --device is required")
+
+    records = RecordParser()
+    summary = Summary()
+    output = open(args.output, "w", newline="\n") if args.output else sys.stdout
+
+    def handle(data):
+        new = records.feed(data)
+        if new and not summary.windows:
+            write_csv_header(new[0], output)
+        for record in new:
+            summary.add(record)
+        write_csv(new, output)
+
+    try:
+        if args.input:
+            with open(args.input, "rb") as f:
+                handle(f.read())
+        else:
+            read_jlink(args, handle)
+    finally:
+        if args.output:
+            output.close()
+
+    summary.write(sys.stderr)
+    if records.dropped:
+        print("%d records dropped" % records.dropped, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
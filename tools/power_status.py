@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Host reader for the low-power status records.
+
+The firmware built with SCAN_SCHEDULER_EN=1u and SCAN_LOW_POWER_EN=1u waits
+for the idle scans in Deep Sleep and writes a status record to its RTT
+up-buffer on each change between full-rate and idle scanning, and every
+SCAN_STATUS_PERIOD_MS. This script reads the records over J-Link, or from a
+file captured with another RTT client, prints them, and at the end reports
+per state the time spent, the share of time awake, the scan rate and, with
+the supply currents of the board given, the average current. It also
+reports the latency from an idle scan that detects a touch to the end of
+the first full-rate scan.
+
+Record layout: 0xA5 sync byte, 8-bit state (0 full rate, 1 idle), 16-bit
+sequence, 32-bit ILO ticks awake, 32-bit ILO ticks in Deep Sleep, 32-bit
+scan count, all since the previous record, and the 32-bit wake latency in
+CPU cycles, non-zero on the first record after waking. All values are
+little-endian. The state applies from the record on, the totals belong to
+the time before it.
+
+Requires pylink-square unless --input is used.
+
+Example:
+    tools/power_status.py --device CY8C4147AZI-S475 --core-clock-hz 48000000 \\
+        --active-ua 2500 --sleep-ua 3 --duration 600
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+STATUS_CHANNEL = 9
+
+SYNC = 0xA5
+RECORD = struct.Struct("<BBHIIII")
+STATES = ("full rate", "idle")
+
+
+class RecordParser:
+    """Splits the byte stream into records, resynchronizing on the sync byte."""
+
+    def __init__(self):
+        self.buffer = b""
+        self.dropped = 0
+        self.sync_errors = 0
+        self.last_sequence = None
+
+    def feed(self, data):
+        self.buffer += data
+        records = []
+        while len(self.buffer) >= RECORD.size:
+            if self.buffer[0] != SYNC or self.buffer[1] >= len(STATES):
+                self.sync_errors += 1
+                self.buffer = self.buffer[1:]
+                continue
+            record = RECORD.unpack_from(self.buffer, 0)
+            sequence = record[2]
+            if self.last_sequence is not None:
+                self.dropped += (sequence - self.last_sequence - 1) & 0xFFFF
+            self.last_sequence = sequence
+            records.append(record[1:])
+            self.buffer = self.buffer[RECORD.size:]
+        return records
+
+
+class Summary:
+    """Totals per state. The totals of a record belong to the state of the
+    record before it."""
+
+    def __init__(self):
+        self.state = None
+        self.awake = [0, 0]
+        self.sleep = [0, 0]
+        self.scans = [0, 0]
+        self.latencies = []
+
+    def add(self, record):
+        state, _, awake, sleep, scans, wake_latency = record
+        if self.state is not None:
+            self.awake[self.state] += awake
+            self.sleep[self.state] += sleep
+            self.scans[self.state] += scans
+        if wake_latency:
+            self.latencies.append(wake_latency)
+        self.state = state
+
+    def write(self, args, output):
+        for state, name in enumerate(STATES):
+            total = self.awake[state] + self.sleep[state]
+            if not total:
+                continue
+            seconds = total / args.ilo_hz
+            duty = self.awake[state] / total
+            line = "%-9s  %9.1f s  awake %6.2f %%  %8.1f scans/s" % (
+                name, seconds, 100.0 * duty, self.scans[state] / seconds)
+            if args.active_ua is not None and args.sleep_ua is not None:
+                current = duty * args.active_ua + (1.0 - duty) * args.sleep_ua
+                line += "  %9.1f uA" % current
+            output.write(line + "\n")
+        if self.latencies:
+            latencies = sorted(self.latencies)
+            if args.core_clock_hz:
+                values = [1000.0 * c / args.core_clock_hz for c in latencies]
+                unit = "ms"
+            else:
+                values = latencies
+                unit = "cycles"
+            output.write("wake latency  %d wakes  min %.3f  median %.3f  max %.3f %s\n" % (
+                len(values), values[0], values[len(values) // 2], values[-1], unit))
+
+
+def print_records(records, output):
+    for state, sequence, awake, sleep, scans, wake_latency in records:
+        output.write("%5d  %-9s  awake %6d  sleep %6d  scans %5d  wake latency %d\n" % (
+            sequence, STATES[state], awake, sleep, scans, wake_latency))
+    output.flush()
+
+
+def read_jlink(args, handle):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > STATUS_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        deadline = time.monotonic() + args.duration if args.duration else None
+        try:
+            while deadline is None or time.monotonic() < deadline:
+                data = jlink.rtt_read(STATUS_CHANNEL, 1024)
+                if data:
+                    handle(bytes(data))
+                else:
+                    time.sleep(0.1)
+        except KeyboardInterrupt:
+            pass
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--device", help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--duration", type=float, help="seconds to read, until Ctrl+C if omitted")
+    parser.add_argument("--input", help="decode a captured binary file instead of reading over J-Link")
+    parser.add_argument("--ilo-hz", type=float, default=40000.0, help="ILO frequency of the board (SCAN_ILO_HZ)")
+    parser.add_argument("--core-clock-hz", type=float,
+                        help="target core clock, the wake latency is printed in cycles if omitted")
+    parser.add_argument("--active-ua", type=float, help="measured supply current while awake, in uA")
+    parser.add_argument("--sleep-ua", type=float, help="measured supply current in Deep Sleep, in uA")
+    args = parser.parse_args()
+    if not args.input and not args.device:
+        parser.error("either --input or --device is required")
+
+    records = RecordParser()
+    summary = Summary()
+
+    def handle(data):
+        new = records.feed(data)
+        for record in new:
+            summary.add(record)
+        print_records(new, sys.stdout)
+
+    if args.input:
+        with open(args.input, "rb") as f:
+            handle(f.read())
+    else:
+        read_jlink(args, handle)
+
+    summary.write(args, sys.stderr)
+    if records.dropped:
+        print("%d records dropped" % records.dropped, file=sys.stderr)
+    if records.sync_errors:
+        print("%d bytes skipped" % records.sync_errors, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
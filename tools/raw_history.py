@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Host reader for the raw count history.
+
+The firmware (RAW_HISTORY_EN=1u) keeps the raw and difference counts of the
+last RAW_HISTORY_DEPTH scans in a RAM ring. When a widget becomes active, or
+when the host requests a dump, the ring is frozen and published on its RTT
+up-buffer, and stays there until it is read. This script reads the history
+over J-Link, optionally requesting an immediate dump, and prints it as CSV.
+
+Record layout: 16-bit sequence, 8-bit sensor count, 8-bit flags (bit 0: the
+trigger scan), then the 16-bit raw count and 16-bit difference count of each
+sensor. All values are little-endian. Records arrive oldest first.
+
+Requires pylink-square.
+
+Example:
+    tools/raw_history.py --device CY8C4147AZI-S475 --now --output history.csv
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+HISTORY_CHANNEL = 6
+DUMP_CHANNEL = 2
+
+FLAG_TRIGGER = 0x01
+
+
+def parse_records(data):
+    """Returns (sequence, flags, [(raw, diff), ...]) for each record."""
+    records = []
+    offset = 0
+    while offset + 4 <= len(data):
+        sequence, sensors, flags = struct.unpack_from("<HBB", data, offset)
+        size = 4 + 4 * sensors
+        if sensors == 0 or offset + size > len(data):
+            break
+        counts = struct.unpack_from("<%dH" % (2 * sensors), data, offset + 4)
+        records.append((sequence, flags, list(zip(counts[0::2], counts[1::2]))))
+        offset += size
+    return records, data[offset:]
+
+
+def write_csv(records, output):
+    sensors = len(records[0][2])
+    output.write("sequence,trigger," + ",".join("raw%d,diff%d" % (i, i) for i in range(sensors)) + "\n")
+    for sequence, flags, counts in records:
+        output.write("%d,%d," % (sequence, 1 if flags & FLAG_TRIGGER else 0))
+        output.write(",".join("%d,%d" % c for c in counts) + "\n")
+
+
+def read_history(args):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > HISTORY_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        if args.now:
+            jlink.rtt_write(DUMP_CHANNEL, [0x44])
+
+        # The history is published in one piece; read until it stops growing
+        data = b""
+        deadline = time.monotonic() + args.timeout
+        while time.monotonic() < deadline:
+            chunk = bytes(jlink.rtt_read(HISTORY_CHANNEL, 4096))
+            if chunk:
+                data += chunk
+            elif data:
+                break
+            time.sleep(0.01)
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+    return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--device", help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--now", action="store_true", help="request a dump instead of waiting for a trigger")
+    parser.add_argument("--timeout", type=float, default=2.0, help="seconds to wait for a published history")
+    parser.add_argument("--input", help="decode a captured binary history instead of reading over J-Link")
+    parser.add_argument("--output", help="CSV file, stdout if omitted")
+    args = parser.parse_args()
+    if not args.input and not args.device:
+        parser.error("either --input or --device is required")
+
+    if args.input:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        data = read_history(args)
+
+    records, rest = parse_records(data)
+    if not records:
+        sys.exit("No history published yet; touch a widget or use --now")
+    if rest:
+        print("%d trailing bytes ignored" % len(rest), file=sys.stderr)
+
+    if args.output:
+        with open(args.output, "w", newline="\n") as f:
+            write_csv(records, f)
+    else:
+        write_csv(records, sys.stdout)
+    print("%d scans" % len(records), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,404 @@
+#!/usr/bin/env python3
+"""Throughput and latency benchmark for the RTT tuner link.
+
+Reads the tuner channel of a board running the benchmark firmware
+(make program BENCHMARK=1) over J-Link and reports the sustained frame rate,
+dropped frames and latency percentiles. Optionally rebuilds and programs the
+firmware for every transport configuration of a sweep.
+
+Every benchmark frame carries the CPU cycle timestamp taken when the frame
+was built and a sequence number incremented per frame. Gaps in the sequence
+are frames that were skipped (streaming) or overwritten before the host read
+them (snapshot). The host and target clocks are not synchronized, so the
+target clock is fitted to the host clock and the reported latency is the
+time above the fastest frame of the run; the fastest frame itself still
+includes one J-Link read.
+
+With --crc the firmware also appends a CRC-16 to every frame
+(RTT_TUNER_CRC_EN); frames that fail the check are counted and excluded.
+
+Requires pylink-square, and pyelftools when the tuner data size is read from
+the ELF file.
+
+Example:
+    tools/rtt_benchmark.py --device CY8C4147AZI-S475 --build \\
+        --transport snapshot stream --stream-frames 2 4 8 \\
+        --up-mode skip block --swd-speed 1000 4000 --poll-ms 0 1 10
+    tools/rtt_benchmark.py --device CY8C4147AZI-S475 --build --crc --swd-speed 12000
+"""
+
+import argparse
+import csv
+import glob
+import itertools
+import os
+import subprocess
+import sys
+import time
+
+TUNER_CHANNEL = 1
+
+HEADER = b"\x0d\x0a"
+TAIL = b"\x00\xff\xff"
+FRAME_TYPE_KEY = 0x00
+FRAME_TYPE_DELTA = 0x01
+CRC_SIZE = 2
+
+UP_MODES = {
+    "skip": "SEGGER_RTT_MODE_NO_BLOCK_SKIP",
+    "block": "SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL",
+}
+
+REPO_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as calculated by the firmware."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class FirmwareConfig:
+    """One transport configuration of the benchmark firmware."""
+
+    def __init__(self, transport, stream_frames=None, up_mode=None, delta=False, crc=False):
+        self.transport = transport
+        self.stream_frames = stream_frames
+        self.up_mode = up_mode
+        self.delta = delta
+        self.crc = crc
+
+    def defines(self):
+        defines = ["RTT_USE_FAST_RTT=%d" % (1 if self.transport == "snapshot" else 0)]
+        if self.transport == "stream":
+            defines.append("RTT_TUNER_STREAM_FRAMES=%du" % self.stream_frames)
+            defines.append("RTT_TUNER_UP_MODE=%s" % UP_MODES[self.up_mode])
+        if self.delta:
+            defines.append("RTT_TUNER_DELTA_EN=1u")
+        if self.crc:
+            defines.append("RTT_TUNER_CRC_EN=1u")
+        return defines
+
+    def name(self):
+        if self.transport == "snapshot":
+            name = "snapshot"
+        else:
+            name = "stream/%d/%s" % (self.stream_frames, self.up_mode)
+        return name + ("/delta" if self.delta else "") + ("/crc" if self.crc else "")
+
+
+class FrameParser:
+    """Splits the tuner byte stream into benchmark frames."""
+
+    def __init__(self, tuner_size, delta, crc=False):
+        self.tuner_size = tuner_size
+        self.delta = delta
+        self.prefix = len(HEADER) + (2 if delta else 0)
+        self.crc_size = CRC_SIZE if crc else 0
+        self.buf = bytearray()
+        self.sync_errors = 0
+        self.crc_errors = 0
+
+    def _payload_length(self, start):
+        """Returns the payload length of the frame at start, or None if more
+        bytes are needed."""
+        data_start = start + self.prefix + 8
+        if not self.delta or self.buf[start + 2] == FRAME_TYPE_KEY:
+            return self.tuner_size
+        if self.buf[start + 2] != FRAME_TYPE_DELTA:
+            return -1
+        pos = data_start
+        if len(self.buf) < pos + 2:
+            return None
+        count = int.from_bytes(self.buf[pos:pos + 2], "little")
+        pos += 2
+        for _ in range(count):
+            if len(self.buf) < pos + 4:
+                return None
+            length = int.from_bytes(self.buf[pos + 2:pos + 4], "little")
+            pos += 4 + length
+            if pos - data_start > self.tuner_size:
+                return -1
+        return pos - data_start
+
+    def feed(self, data):
+        """Appends received bytes, returns a list of (timestamp, sequence)."""
+        self.buf += data
+        frames = []
+        while True:
+            start = self.buf.find(HEADER)
+            if start < 0:
+                # Keep a trailing first header byte
+                keep = 1 if self.buf.endswith(HEADER[:1]) else 0
+                if len(self.buf) > keep:
+                    self.sync_errors += 1
+                    del self.buf[:len(self.buf) - keep]
+                break
+            if start > 0:
+                self.sync_errors += 1
+                del self.buf[:start]
+            if len(self.buf) < self.prefix + 8:
+                break
+            length = self._payload_length(0)
+            if length is None:
+                break
+            end = self.prefix + 8 + (length if length >= 0 else 0)
+            tail = end + self.crc_size
+            if length < 0 or (len(self.buf) >= tail + len(TAIL) and
+                              self.buf[tail:tail + len(TAIL)] != TAIL):
+                # Not a frame, resynchronize on the next header
+                self.sync_errors += 1
+                del self.buf[:1]
+                continue
+            if len(self.buf) < tail + len(TAIL):
+                break
+            if self.crc_size and crc16(self.buf[:end]) != int.from_bytes(self.buf[end:tail], "little"):
+                self.crc_errors += 1
+            else:
+                timestamp = int.from_bytes(self.buf[self.prefix:self.prefix + 4], "little")
+                sequence = int.from_bytes(self.buf[self.prefix + 4:self.prefix + 8], "little")
+                frames.append((timestamp, sequence))
+            del self.buf[:tail + len(TAIL)]
+        return frames
+
+
+def unwrap(values, bits=32):
+    """Removes counter wraps from a monotonic sequence of values."""
+    out = []
+    offset = 0
+    prev = None
+    for value in values:
+        if prev is not None and value < prev:
+            offset += 1 << bits
+        prev = value
+        out.append(value + offset)
+    return out
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return float("nan")
+    index = min(int(fraction * len(sorted_values)), len(sorted_values) - 1)
+    return sorted_values[index]
+
+
+def analyze(samples, duration, core_clock_hz):
+    """Computes the statistics of one run from (host_time, timestamp, sequence)."""
+    result = {"frames": 0, "dropped": 0, "duplicates": 0, "fps": 0.0,
+              "clock_hz": float("nan"), "lat_p50_ms": float("nan"),
+              "lat_p90_ms": float("nan"), "lat_p99_ms": float("nan"),
+              "lat_max_ms": float("nan")}
+    if not samples:
+        return result
+
+    host = [s[0] for s in samples]
+    cycles = unwrap([s[1] for s in samples])
+    sequence = unwrap([s[2] for s in samples])
+
+    unique = [0]
+    for i in range(1, len(samples)):
+        gap = sequence[i] - sequence[i - 1]
+        if gap == 0:
+            result["duplicates"] += 1
+            continue
+        result["dropped"] += gap - 1
+        unique.append(i)
+    result["frames"] = len(unique)
+    result["fps"] = len(unique) / duration
+
+    host = [host[i] for i in unique]
+    cycles = [cycles[i] for i in unique]
+
+    # Target seconds per cycle, fitted unless the core clock is given
+    if core_clock_hz:
+        slope = 1.0 / core_clock_hz
+    elif len(cycles) > 1 and cycles[-1] != cycles[0]:
+        mean_c = sum(cycles) / len(cycles)
+        mean_h = sum(host) / len(host)
+        num = sum((c - mean_c) * (h - mean_h) for c, h in zip(cycles, host))
+        den = sum((c - mean_c) ** 2 for c in cycles)
+        slope = num / den
+    else:
+        return result
+    result["clock_hz"] = 1.0 / slope
+
+    offsets = [h - c * slope for c, h in zip(cycles, host)]
+    floor = min(offsets)
+    latency = sorted((o - floor) * 1000.0 for o in offsets)
+    result["lat_p50_ms"] = percentile(latency, 0.50)
+    result["lat_p90_ms"] = percentile(latency, 0.90)
+    result["lat_p99_ms"] = percentile(latency, 0.99)
+    result["lat_max_ms"] = latency[-1]
+    return result
+
+
+def tuner_size_from_elf(path):
+    from elftools.elf.elffile import ELFFile
+
+    with open(path, "rb") as f:
+        symtab = ELFFile(f).get_section_by_name(".symtab")
+        symbols = symtab.get_symbol_by_name("cy_capsense_tuner") if symtab else None
+        if not symbols:
+            sys.exit("%s: symbol cy_capsense_tuner not found" % path)
+        return symbols[0]["st_size"]
+
+
+def find_elf():
+    elfs = glob.glob(os.path.join(REPO_DIR, "build", "**", "*.elf"), recursive=True)
+    if not elfs:
+        sys.exit("No ELF file found in build/, use --elf or --tuner-size")
+    return max(elfs, key=os.path.getmtime)
+
+
+def program(config, make):
+    print("== programming %s" % config.name(), flush=True)
+    subprocess.run([make, "program", "BENCHMARK=1",
+                    "BENCHMARK_DEFINES=%s" % " ".join(config.defines())],
+                   cwd=REPO_DIR, check=True)
+
+
+def run(args, config, tuner_size, swd_speed, poll_ms):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > TUNER_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        parser = FrameParser(tuner_size, config.delta, config.crc)
+        samples = []
+
+        # Discard what was buffered before the measurement starts
+        jlink.rtt_read(TUNER_CHANNEL, args.read_size)
+        start = time.perf_counter()
+        end = start + args.duration
+        while True:
+            now = time.perf_counter()
+            if now >= end:
+                break
+            data = jlink.rtt_read(TUNER_CHANNEL, args.read_size)
+            now = time.perf_counter()
+            for timestamp, sequence in parser.feed(bytes(data)):
+                samples.append((now, timestamp, sequence))
+            if poll_ms > 0:
+                time.sleep(poll_ms / 1000.0)
+        duration = time.perf_counter() - start
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+
+    result = analyze(samples, duration, args.core_clock_hz)
+    result["sync_errors"] = parser.sync_errors
+    result["crc_errors"] = parser.crc_errors
+    return result
+
+
+def firmware_configs(args):
+    configs = []
+    for transport in args.transport:
+        if transport == "snapshot":
+            configs.append(FirmwareConfig("snapshot", delta=args.delta, crc=args.crc))
+        else:
+            for frames, mode in itertools.product(args.stream_frames, args.up_mode):
+                configs.append(FirmwareConfig("stream", frames, mode, args.delta, args.crc))
+    return configs
+
+
+COLUMNS = ["config", "swd_khz", "poll_ms", "frames", "fps", "dropped",
+           "duplicates", "sync_errors", "crc_errors", "clock_hz", "lat_p50_ms", "lat_p90_ms",
+           "lat_p99_ms", "lat_max_ms"]
+
+
+def print_row(row):
+    cells = []
+    for column in COLUMNS:
+        value = row[column]
+        cells.append("%.2f" % value if isinstance(value, float) else str(value))
+    print("  ".join(cells), flush=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--device", required=True, help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--build", action="store_true",
+                        help="build and program the firmware for every configuration")
+    parser.add_argument("--make", default="make", help="make executable")
+    parser.add_argument("--elf", help="ELF file to read the tuner data size from")
+    parser.add_argument("--tuner-size", type=int,
+                        help="sizeof(cy_capsense_tuner), instead of reading the ELF file")
+    parser.add_argument("--transport", nargs="+", choices=["snapshot", "stream"],
+                        default=["snapshot"])
+    parser.add_argument("--stream-frames", nargs="+", type=int, default=[4],
+                        help="RTT_TUNER_STREAM_FRAMES values (streaming only)")
+    parser.add_argument("--up-mode", nargs="+", choices=sorted(UP_MODES), default=["skip"],
+                        help="RTT_TUNER_UP_MODE values (streaming only)")
+    parser.add_argument("--delta", action="store_true", help="firmware uses delta frames")
+    parser.add_argument("--crc", action="store_true", help="firmware appends a CRC to every frame")
+    parser.add_argument("--swd-speed", nargs="+", type=int, default=[4000],
+                        help="J-Link interface speeds in kHz")
+    parser.add_argument("--poll-ms", nargs="+", type=float, default=[0.0],
+                        help="host delay between two RTT reads in ms")
+    parser.add_argument("--read-size", type=int, default=4096,
+                        help="maximum bytes per RTT read")
+    parser.add_argument("--duration", type=float, default=10.0,
+                        help="measurement time per run in seconds")
+    parser.add_argument("--core-clock-hz", type=float,
+                        help="target core clock, fitted from the timestamps if omitted")
+    parser.add_argument("--csv", help="also write the results to this CSV file")
+    args = parser.parse_args()
+
+    configs = firmware_configs(args)
+    if not args.build and len(configs) > 1:
+        parser.error("sweeping firmware configurations requires --build")
+
+    writer = None
+    if args.csv:
+        csv_file = open(args.csv, "w", newline="")
+        writer = csv.DictWriter(csv_file, fieldnames=COLUMNS)
+        writer.writeheader()
+
+    print("  ".join(COLUMNS))
+    for config in configs:
+        if args.build:
+            program(config, args.make)
+        if args.tuner_size:
+            tuner_size = args.tuner_size
+        else:
+            tuner_size = tuner_size_from_elf(args.elf or find_elf())
+
+        for swd_speed, poll_ms in itertools.product(args.swd_speed, args.poll_ms):
+            row = run(args, config, tuner_size, swd_speed, poll_ms)
+            row.update(config=config.name(), swd_khz=swd_speed, poll_ms=poll_ms)
+            print_row(row)
+            if writer:
+                writer.writerow(row)
+
+    if writer:
+        csv_file.close()
+
+
+if __name__ == "__main__":
+    main()
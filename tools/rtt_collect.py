@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+"""Multi-board tuner stream collector for test racks.
+
+Attaches to many J-Link probes at once, one process per probe, reads the
+tuner channel of each board and writes a columnar log per board. All boards
+share one host time base, so their logs can be aligned sample by sample.
+
+The RTT control block is taken from the _SEGGER_RTT symbol of the ELF file,
+so J-Link does not have to search the target RAM for it; --rtt-address
+gives it directly for a build with RTT_CB_ADDRESS. Without either, J-Link
+searches as usual. The frame options must match the firmware build:
+--stream for the streaming transport (timestamped frames), --sequence,
+--crc and --delta for RTT_TUNER_SEQUENCE_EN, RTT_TUNER_CRC_EN and
+RTT_TUNER_DELTA_EN. Delta frames are applied to the last keyframe, so the
+log always holds complete tuner data. Compact, alias and direct builds are
+not supported.
+
+Log layout, one directory per board:
+    meta.json       probe, device, frame options, column types, start time
+    host_ns.u64     host receive time in ns since the start of the run
+    target_ts.u32   CPU cycle timestamp of the frame, 0 if not sent
+    sequence.u32    frame sequence number, 0 if not sent
+    tuner.bin       complete tuner data of each frame, tuner_size bytes each
+All columns are little-endian and have one entry per frame, so each file can
+be memory-mapped, e.g. with numpy.memmap(path, dtype="<u8").
+
+Requires pylink-square, and pyelftools when --elf is used.
+
+Example:
+    tools/rtt_collect.py --all --device CY8C4147AZI-S475 --elf build/APP_CY8CKIT-149/Debug/app.elf \\
+        --stream --sequence --duration 3600 --output rack
+"""
+
+import argparse
+import json
+import multiprocessing
+import os
+import struct
+import sys
+import time
+
+TUNER_CHANNEL = 1
+
+HEADER = b"\x0d\x0a"
+TAIL = b"\x00\xff\xff"
+FRAME_TYPE_KEY = 0x00
+FRAME_TYPE_DELTA = 0x01
+CRC_SIZE = 2
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as calculated by the firmware."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class FrameParser:
+    """Splits the tuner byte stream into frames and rebuilds the complete
+    tuner data of delta frames."""
+
+    def __init__(self, tuner_size, timestamp, sequence, crc, delta):
+        self.tuner_size = tuner_size
+        self.timestamp = timestamp
+        self.sequence = sequence
+        self.delta = delta
+        self.prefix = len(HEADER) + (2 if delta else 0)
+        self.fixed = self.prefix + (4 if timestamp else 0) + (4 if sequence else 0)
+        self.crc_size = CRC_SIZE if crc else 0
+        self.buf = bytearray()
+        self.shadow = None
+        self.sync_errors = 0
+        self.crc_errors = 0
+
+    def _payload_length(self):
+        """Returns the payload length of the frame at the start of the buffer,
+        None if more bytes are needed, or -1 if it is not a frame."""
+        if not self.delta or self.buf[2] == FRAME_TYPE_KEY:
+            return self.tuner_size
+        if self.buf[2] != FRAME_TYPE_DELTA:
+            return -1
+        pos = self.fixed
+        if len(self.buf) < pos + 2:
+            return None
+        count = int.from_bytes(self.buf[pos:pos + 2], "little")
+        pos += 2
+        for _ in range(count):
+            if len(self.buf) < pos + 4:
+                return None
+            offset, length = struct.unpack_from("<HH", self.buf, pos)
+            pos += 4 + length
+            if offset + length > self.tuner_size or pos - self.fixed > self.tuner_size + 2:
+                return -1
+        return pos - self.fixed
+
+    def _apply(self, payload):
+        """Returns the complete tuner data of a frame payload, or None while no
+        keyframe has been received."""
+        if not self.delta or self.buf[2] == FRAME_TYPE_KEY:
+            self.shadow = bytearray(payload)
+            return bytes(payload)
+        if self.shadow is None:
+            return None
+        count = int.from_bytes(payload[0:2], "little")
+        pos = 2
+        for _ in range(count):
+            offset, length = struct.unpack_from("<HH", payload, pos)
+            self.shadow[offset:offset + length] = payload[pos + 4:pos + 4 + length]
+            pos += 4 + length
+        return bytes(self.shadow)
+
+    def feed(self, data):
+        """Appends received bytes, returns a list of (timestamp, sequence, tuner data)."""
+        self.buf += data
+        frames = []
+        while True:
+            start = self.buf.find(HEADER)
+            if start < 0:
+                # Keep a trailing first header byte
+                keep = 1 if self.buf.endswith(HEADER[:1]) else 0
+                if len(self.buf) > keep:
+                    self.sync_errors += 1
+                    del self.buf[:len(self.buf) - keep]
+                break
+            if start > 0:
+                self.sync_errors += 1
+                del self.buf[:start]
+            if len(self.buf) < self.fixed:
+                break
+            length = self._payload_length()
+            if length is None:
+                break
+            end = self.fixed + (length if length >= 0 else 0)
+            tail = end + self.crc_size
+            if length < 0 or (len(self.buf) >= tail + len(TAIL) and
+                              self.buf[tail:tail + len(TAIL)] != TAIL):
+                # Not a frame, resynchronize on the next header
+                self.sync_errors += 1
+                del self.buf[:1]
+                continue
+            if len(self.buf) < tail + len(TAIL):
+                break
+            if self.crc_size and crc16(self.buf[:end]) != int.from_bytes(self.buf[end:tail], "little"):
+                self.crc_errors += 1
+            else:
+                pos = self.prefix
+                timestamp = 0
+                sequence = 0
+                if self.timestamp:
+                    timestamp = int.from_bytes(self.buf[pos:pos + 4], "little")
+                    pos += 4
+                if self.sequence:
+                    sequence = int.from_bytes(self.buf[pos:pos + 4], "little")
+                tuner = self._apply(self.buf[self.fixed:end])
+                if tuner is not None:
+                    frames.append((timestamp, sequence, tuner))
+            del self.buf[:tail + len(TAIL)]
+        return frames
+
+
+class BoardLog:
+    """Appends frames to the column files of one board."""
+
+    COLUMNS = [("host_ns", "<u8"), ("target_ts", "<u4"), ("sequence", "<u4")]
+
+    def __init__(self, directory, meta):
+        os.makedirs(directory, exist_ok=True)
+        self.directory = directory
+        self.meta = meta
+        self.frames = 0
+        self.host_ns = open(os.path.join(directory, "host_ns.u64"), "wb")
+        self.target_ts = open(os.path.join(directory, "target_ts.u32"), "wb")
+        self.sequence = open(os.path.join(directory, "sequence.u32"), "wb")
+        self.tuner = open(os.path.join(directory, "tuner.bin"), "wb")
+        self.write_meta()
+
+    def append(self, host_ns, frames):
+        for timestamp, sequence, tuner in frames:
+            self.host_ns.write(struct.pack("<Q", host_ns))
+            self.target_ts.write(struct.pack("<I", timestamp))
+            self.sequence.write(struct.pack("<I", sequence))
+            self.tuner.write(tuner)
+        self.frames += len(frames)
+
+    def write_meta(self, **stats):
+        self.meta.update(frames=self.frames, **stats)
+        with open(os.path.join(self.directory, "meta.json"), "w") as f:
+            json.dump(self.meta, f, indent=2)
+
+    def close(self, **stats):
+        for f in (self.host_ns, self.target_ts, self.sequence, self.tuner):
+            f.close()
+        self.write_meta(**stats)
+
+
+def tuner_symbols(path):
+    """Returns the size of cy_capsense_tuner and the address of _SEGGER_RTT."""
+    from elftools.elf.elffile import ELFFile
+
+    with open(path, "rb") as f:
+        symtab = ELFFile(f).get_section_by_name(".symtab")
+        if symtab is None:
+            sys.exit("%s: no symbol table" % path)
+        tuner = symtab.get_symbol_by_name("cy_capsense_tuner")
+        control_block = symtab.get_symbol_by_name("_SEGGER_RTT")
+        if not tuner or not control_block:
+            sys.exit("%s: symbol cy_capsense_tuner or _SEGGER_RTT not found" % path)
+        return tuner[0]["st_size"], control_block[0]["st_value"]
+
+
+def collect(args, serial, device, start_ns, tuner_size, block_address):
+    """Reads one board until the deadline, runs in its own process."""
+    import pylink
+
+    meta = {
+        "serial": serial,
+        "device": device,
+        "tuner_size": tuner_size,
+        "stream": args.stream,
+        "sequence": args.sequence,
+        "crc": args.crc,
+        "delta": args.delta,
+        "start_unix_ns": args.start_unix_ns,
+        "columns": {name: dtype for name, dtype in BoardLog.COLUMNS},
+        "tuner": "%d bytes per frame" % tuner_size,
+    }
+    log = BoardLog(os.path.join(args.output, str(serial)), meta)
+    parser = FrameParser(tuner_size, args.stream, args.sequence, args.crc, args.delta)
+
+    jlink = pylink.JLink()
+    error = None
+    try:
+        jlink.open(serial_no=serial)
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(device)
+        jlink.rtt_start(block_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > TUNER_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                raise RuntimeError("RTT control block not found")
+            time.sleep(0.01)
+
+        end_ns = start_ns + int(args.duration * 1e9)
+        while True:
+            now = time.monotonic_ns()
+            if now >= end_ns:
+                break
+            data = jlink.rtt_read(TUNER_CHANNEL, args.read_size)
+            if data:
+                log.append(time.monotonic_ns() - start_ns, parser.feed(bytes(data)))
+            elif args.poll_ms > 0:
+                time.sleep(args.poll_ms / 1000.0)
+        jlink.rtt_stop()
+    except KeyboardInterrupt:
+        pass
+    except Exception as e:
+        error = str(e)
+    finally:
+        if jlink.opened():
+            jlink.close()
+        log.close(sync_errors=parser.sync_errors, crc_errors=parser.crc_errors, error=error)
+
+    status = "error: %s" % error if error else "ok"
+    print("%-12s %-20s %8d frames %6d sync %6d crc  %s" % (
+        serial, device, log.frames, parser.sync_errors, parser.crc_errors, status), flush=True)
+
+
+def probe_list(args):
+    """Returns (serial, device) for every probe to read."""
+    probes = []
+    for probe in args.probe:
+        serial, _, device = probe.partition(":")
+        probes.append((int(serial), device or args.device))
+    if args.all:
+        import pylink
+
+        for emulator in pylink.JLink().connected_emulators():
+            if emulator.SerialNumber not in [p[0] for p in probes]:
+                probes.append((emulator.SerialNumber, args.device))
+    for serial, device in probes:
+        if not device:
+            sys.exit("no device name for probe %d, use --device or SERIAL:DEVICE" % serial)
+    return probes
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--probe", action="append", default=[], metavar="SERIAL[:DEVICE]",
+                        help="J-Link serial number, optionally with the device name of its board")
+    parser.add_argument("--all", action="store_true", help="read every connected J-Link")
+    parser.add_argument("--device", help="J-Link device name of the boards")
+    parser.add_argument("--elf", help="firmware ELF file, for the tuner data size and the control block address")
+    parser.add_argument("--tuner-size", type=int, help="sizeof(cy_capsense_tuner), instead of reading the ELF file")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), instead of reading the ELF file")
+    parser.add_argument("--stream", action="store_true", help="firmware uses the streaming transport")
+    parser.add_argument("--sequence", action="store_true", help="frames carry a sequence number")
+    parser.add_argument("--crc", action="store_true", help="frames carry a CRC-16")
+    parser.add_argument("--delta", action="store_true", help="firmware sends delta frames")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--read-size", type=int, default=4096, help="maximum bytes per RTT read")
+    parser.add_argument("--poll-ms", type=float, default=1.0, help="delay after an empty RTT read in ms")
+    parser.add_argument("--duration", type=float, default=60.0, help="seconds to read")
+    parser.add_argument("--output", default="rtt_logs", help="directory for the board logs")
+    args = parser.parse_args()
+
+    probes = probe_list(args)
+    if not probes:
+        parser.error("no probes, use --probe or --all")
+    if args.elf:
+        tuner_size, block_address = tuner_symbols(args.elf)
+    elif args.tuner_size:
+        tuner_size, block_address = args.tuner_size, None
+    else:
+        parser.error("either --elf or --tuner-size is required")
+    if args.tuner_size:
+        tuner_size = args.tuner_size
+    if args.rtt_address is not None:
+        block_address = args.rtt_address
+
+    # The monotonic clock is shared by all processes on the host, the wall
+    # clock start is only recorded to place the run in time
+    args.start_unix_ns = time.time_ns()
+    start_ns = time.monotonic_ns()
+
+    processes = [multiprocessing.Process(target=collect,
+                                         args=(args, serial, device, start_ns, tuner_size, block_address))
+                 for serial, device in probes]
+    for process in processes:
+        process.start()
+    try:
+        for process in processes:
+            process.join()
+    except KeyboardInterrupt:
+        for process in processes:
+            process.join()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""RTT RAM footprint report.
+
+Reads GCC linker map files and lists the RAM taken by the RTT control block
+and by the buffers and state of every RTT module: terminal, tuner, profiler,
+touch events, deferred logging, raw count history, noise metrics, signal
+statistics, the low-power scan scheduler and the tuning profile store. Pass
+the map files of several builds, for example the default build and
+MEMORY_BUDGET=1, to compare them side by side. The build must use -fdata-sections, as the ModusToolbox
+GCC build does, so that every variable has its own section.
+
+Example:
+    tools/rtt_footprint.py build/APP_CY8CKIT-149/Debug/mtb-example-psoc4-capsense-buttons-slider-rtt.map
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+REPO_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Object file -> module name in the report
+MODULES = {
+    "SEGGER_RTT": "RTT control block and terminal",
+    "rtt_tuner": "Tuner",
+    "profiler": "Profiler",
+    "touch_events": "Touch events",
+    "deferred_log": "Deferred logging",
+    "raw_history": "Raw count history",
+    "noise_metrics": "Noise metrics",
+    "signal_stats": "Signal statistics",
+    "scan_scheduler": "Scan scheduler and power status",
+    "tuning_store": "Tuning profile store",
+}
+
+# One input section per variable: name, then address, size and object file,
+# on the same line or on the next one when the name is long. With
+# RTT_CB_ADDRESS, the control block has its own .segger_rtt section.
+SECTION = re.compile(r"^ \.(?:(?:bss|data|noinit)\.(\w+)|segger_rtt)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+\.o)\b", re.M)
+CONTROL_BLOCK = "_SEGGER_RTT"
+RAM_REGION = re.compile(r"^(\w*ram\w*)\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)", re.M | re.I)
+
+
+def read_map(path):
+    """Returns ({module: {symbol: size}}, RAM size or None)."""
+    with open(path, errors="replace") as f:
+        text = f.read()
+    modules = {}
+    for symbol, _, size, obj in SECTION.findall(text):
+        base = os.path.splitext(os.path.basename(obj))[0]
+        if base in MODULES and int(size, 16):
+            modules.setdefault(base, {})[symbol or CONTROL_BLOCK] = int(size, 16)
+    ram = RAM_REGION.search(text)
+    return modules, int(ram.group(2), 16) if ram else None
+
+
+def find_map():
+    maps = glob.glob(os.path.join(REPO_DIR, "build", "**", "*.map"), recursive=True)
+    if not maps:
+        sys.exit("No map file found in build/, pass the map files to compare")
+    return max(maps, key=os.path.getmtime)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("maps", nargs="*", help="linker map files, the newest one in build/ if omitted")
+    parser.add_argument("--labels", nargs="+", help="column titles, the map file names if omitted")
+    parser.add_argument("--symbols", action="store_true", help="list every variable, not only the module totals")
+    args = parser.parse_args()
+
+    paths = args.maps or [find_map()]
+    labels = args.labels or [os.path.splitext(os.path.basename(p))[0] for p in paths]
+    if len(labels) != len(paths):
+        parser.error("--labels needs one title per map file")
+    builds = [read_map(p) for p in paths]
+
+    width = max(len(label) for label in labels + ["bytes"]) + 2
+    rows = []
+    for module, title in MODULES.items():
+        if not any(module in b[0] for b in builds):
+            continue
+        rows.append((title, [sum(b[0].get(module, {}).values()) for b in builds]))
+        if args.symbols:
+            symbols = sorted({s for b in builds for s in b[0].get(module, {})})
+            for symbol in symbols:
+                rows.append(("  " + symbol, [b[0].get(module, {}).get(symbol, 0) for b in builds]))
+    totals = [sum(sum(m.values()) for m in b[0].values()) for b in builds]
+
+    name_width = max([len(r[0]) for r in rows] + [len("Total")]) + 2
+    print("".ljust(name_width) + "".join(label.rjust(width) for label in labels))
+    for name, sizes in rows:
+        print(name.ljust(name_width) + "".join(("%d" % s).rjust(width) for s in sizes))
+    print("Total".ljust(name_width) + "".join(("%d" % t).rjust(width) for t in totals))
+    if all(b[1] for b in builds):
+        print("of RAM".ljust(name_width) + "".join(("%.1f%%" % (100.0 * t / b[1])).rjust(width)
+                                                   for t, b in zip(totals, builds)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""Host reader for the signal statistics.
+
+The firmware (SIGNAL_STATS_EN=1u) keeps running statistics of every sensor
+and writes one summary record per SIGNAL_STATS_INTERVAL scans to its RTT
+up-buffer, so a soak test needs a few bytes per interval instead of the full
+tuner stream. This script reads the records over J-Link, or from a file
+captured with another RTT client, and writes them as CSV with one row per
+sensor and interval.
+
+Record layout: 16-bit sequence, 8-bit sensor count, reserved byte, 32-bit
+scan count, 32-bit CPU cycle timestamp, then per sensor the 16-bit RMS noise
+in 1/16 counts, 16-bit mean touch signal, 16-bit SNR in 1/16 steps, 16-bit
+smallest and largest difference count, and the signed 16-bit baseline
+change. All values are little-endian.
+
+Requires pylink-square unless --input is used.
+
+Example:
+    tools/signal_stats.py --device CY8C4147AZI-S475 --core-clock-hz 48000000 --output soak.csv
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+STATS_CHANNEL = 8
+
+HEADER_SIZE = 12
+ENTRY_SIZE = 12
+
+
+class RecordParser:
+    """Splits the byte stream into records of
+    (sequence, scans, time, [(noise, signal, snr, diff_min, diff_max, drift), ...])."""
+
+    def __init__(self):
+        self.buffer = b""
+        self.dropped = 0
+        self.last_sequence = None
+
+    def feed(self, data):
+        self.buffer += data
+        records = []
+        while len(self.buffer) >= HEADER_SIZE:
+            sequence, sensors, _, scans, timestamp = struct.unpack_from("<HBBII", self.buffer, 0)
+            size = HEADER_SIZE + ENTRY_SIZE * sensors
+            if len(self.buffer) < size:
+                break
+            entries = [struct.unpack_from("<HHHHHh", self.buffer, HEADER_SIZE + ENTRY_SIZE * i)
+                       for i in range(sensors)]
+            records.append((sequence, scans, timestamp, entries))
+            if self.last_sequence is not None:
+                self.dropped += (sequence - self.last_sequence - 1) & 0xFFFF
+            self.last_sequence = sequence
+            self.buffer = self.buffer[size:]
+        return records
+
+
+class Clock:
+    """Extends the 32-bit cycle timestamp and formats it in seconds."""
+
+    def __init__(self, core_clock_hz):
+        self.core_clock_hz = core_clock_hz
+        self.last = None
+        self.high = 0
+
+    def __call__(self, timestamp):
+        if self.last is not None and timestamp < self.last:
+            self.high += 1 << 32
+        self.last = timestamp
+        cycles = self.high + timestamp
+        if self.core_clock_hz:
+            return "%.6f" % (cycles / self.core_clock_hz)
+        return "%d" % cycles
+
+
+def write_csv(records, clock, output):
+    for sequence, scans, timestamp, entries in records:
+        now = clock(timestamp)
+        for sensor, (noise, signal, snr, diff_min, diff_max, drift) in enumerate(entries):
+            output.write("%d,%s,%d,%d,%.4f,%d,%.4f,%d,%d,%d\n" % (
+                sequence, now, scans, sensor, noise / 16.0, signal, snr / 16.0, diff_min, diff_max, drift))
+    output.flush()
+
+
+def read_jlink(args, handle):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > STATS_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        deadline = time.monotonic() + args.duration if args.duration else None
+        try:
+            while deadline is None or time.monotonic() < deadline:
+                data = jlink.rtt_read(STATS_CHANNEL, 4096)
+                if data:
+                    handle(bytes(data))
+                else:
+                    time.sleep(0.1)
+        except KeyboardInterrupt:
+            pass
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--device", help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--core-clock-hz", type=float,
+                        help="target core clock, timestamps are written in cycles if omitted")
+    parser.add_argument("--duration", type=float, help="seconds to read, until Ctrl+C if omitted")
+    parser.add_argument("--input", help="decode a captured binary file instead of reading over J-Link")
+    parser.add_argument("--output", help="CSV file, stdout if omitted")
+    args = parser.parse_args()
+    if not args.input and not args.device:
+        parser.error("either --input or --device is required")
+
+    records = RecordParser()
+    clock = Clock(args.core_clock_hz)
+    output = open(args.output, "w", newline="\n") if args.output else sys.stdout
+    output.write("sequence,time,scans,sensor,noise,signal,snr,diff_min,diff_max,drift\n")
+
+    def handle(data):
+        write_csv(records.feed(data), clock, output)
+
+    try:
+        if args.input:
+            with open(args.input, "rb") as f:
+                handle(f.read())
+        else:
+            read_jlink(args, handle)
+    finally:
+        if args.output:
+            output.close()
+
+    if records.dropped:
+        print("%d records dropped" % records.dropped, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
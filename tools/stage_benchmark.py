@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""Per-stage timing benchmark for performance regression checks.
+
+The benchmark firmware (make program STAGE_BENCHMARK=1) runs
+PROFILER_BENCHMARK_WARMUP scan cycles, restarts the profiler statistics, runs
+PROFILER_BENCHMARK_CYCLES more, writes one profiler report and stops. The
+"run" command resets the board, reads the report over J-Link, and saves it as
+JSON; with --target it first builds and programs the firmware for each board
+template. The "compare" command prints the saved results side by side and,
+with --tolerance, fails when the average of a stage grew by more than the
+given percentage over the first file.
+
+Each report record: 0x0D 0x50 header, 8-bit stage, 8-bit histogram bin
+count, 32-bit core clock in Hz, 32-bit sample count, 32-bit minimum, maximum
+and average in CPU cycles, and 16 16-bit histogram counters. All values are
+little-endian.
+
+Requires pylink-square for the "run" command.
+
+Example:
+    tools/stage_benchmark.py run --target CY8CKIT-149:CY8C4147AZI-S475 \\
+        --target CY8CKIT-045S:CY8C4548AZI-S485 --output-dir results/new
+    tools/stage_benchmark.py compare results/base/CY8CKIT-149.json \\
+        results/new/CY8CKIT-149.json --tolerance 5
+"""
+
+import argparse
+import json
+import os
+import struct
+import subprocess
+import sys
+import time
+
+PROFILER_CHANNEL = 2
+
+HEADER = b"\x0d\x50"
+RECORD = struct.Struct("<2sBBIIIII16H")
+
+# In the order of profiler_stage_t
+STAGES = ["scan", "process", "tuner", "cycle", "isr", "irq_latency", "filter", "report"]
+
+REPO_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+class ReportParser:
+    """Collects the records of one report, resynchronizing on the header."""
+
+    def __init__(self):
+        self.buffer = b""
+        self.records = {}
+        self.core_clock_hz = None
+
+    def feed(self, data):
+        self.buffer += data
+        while len(self.buffer) >= RECORD.size:
+            if self.buffer[:2] != HEADER:
+                self.buffer = self.buffer[1:]
+                continue
+            _, stage, bins, clock, count, minimum, maximum, average, *hist = \
+                RECORD.unpack_from(self.buffer, 0)
+            self.buffer = self.buffer[RECORD.size:]
+            name = STAGES[stage] if stage < len(STAGES) else "stage%d" % stage
+            self.core_clock_hz = clock
+            self.records[name] = {"count": count, "min": minimum, "max": maximum,
+                                  "avg": average, "hist": hist[:bins]}
+        return self.complete()
+
+    def complete(self):
+        return "report" in self.records
+
+
+def program(target, defines, make):
+    print("== programming %s" % target, flush=True)
+    command = [make, "program", "TARGET=%s" % target, "STAGE_BENCHMARK=1"]
+    if defines:
+        command.append("STAGE_BENCHMARK_DEFINES=%s" % defines)
+    subprocess.run(command, cwd=REPO_DIR, check=True)
+
+
+def read_report(args, device):
+    import pylink
+
+    parser = ReportParser()
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(device)
+
+        # Start the benchmark from the reset, RTT is set up again by the firmware
+        jlink.reset(halt=False)
+        jlink.rtt_start(args.rtt_address)
+
+        deadline = time.monotonic() + args.timeout
+        while not parser.complete():
+            if time.monotonic() > deadline:
+                sys.exit("No complete profiler report within %.0f s" % args.timeout)
+            try:
+                if jlink.rtt_get_num_up_buffers() <= PROFILER_CHANNEL:
+                    time.sleep(0.01)
+                    continue
+                data = jlink.rtt_read(PROFILER_CHANNEL, 1024)
+            except pylink.errors.JLinkRTTException:
+                time.sleep(0.01)
+                continue
+            if data:
+                parser.feed(bytes(data))
+            else:
+                time.sleep(0.05)
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+    return parser
+
+
+def result(parser, label):
+    return {"label": label, "core_clock_hz": parser.core_clock_hz,
+            "cycles": parser.records.get("cycle", {}).get("count", 0),
+            "stages": parser.records}
+
+
+def run(args):
+    if args.label and args.target and len(args.target) > 1:
+        sys.exit("--label names a single result, the results of several targets are named after them")
+    if args.target:
+        targets = []
+        for spec in args.target:
+            target, _, device = spec.partition(":")
+            if not device and not args.device:
+                sys.exit("--target %s needs a device, use TARGET:DEVICE or --device" % target)
+            targets.append((target, device or args.device))
+    elif args.device:
+        targets = [(args.label or "benchmark", args.device)]
+    elif not args.input:
+        sys.exit("either --input, --device, or --target is required")
+    else:
+        targets = []
+
+    if args.input:
+        parser = ReportParser()
+        with open(args.input, "rb") as f:
+            parser.feed(f.read())
+        if not parser.complete():
+            sys.exit("%s holds no complete profiler report" % args.input)
+        results = [result(parser, args.label or os.path.splitext(os.path.basename(args.input))[0])]
+    else:
+        results = []
+        for target, device in targets:
+            if args.target:
+                program(target, args.defines, args.make)
+            results.append(result(read_report(args, device), args.label or target))
+
+    if args.output_dir:
+        os.makedirs(args.output_dir, exist_ok=True)
+    for entry in results:
+        with open(os.path.join(args.output_dir or ".", entry["label"] + ".json"), "w") as f:
+            json.dump(entry, f, indent=2)
+    print_table(results)
+
+
+def print_table(results, baseline=None, tolerance=None):
+    """Prints the average and maximum cycles of each stage, one column pair
+    per result. Returns the regressions against the baseline."""
+    regressions = []
+    width = max([len(r["label"]) for r in results] + [18]) + 2
+    print("stage".ljust(14) + "".join(r["label"].rjust(width) for r in results))
+    print("core clock Hz".ljust(14) + "".join(("%d" % r["core_clock_hz"]).rjust(width) for r in results))
+    print("cycles".ljust(14) + "".join(("%d" % r["cycles"]).rjust(width) for r in results))
+    names = [s for s in STAGES if any(r["stages"].get(s, {}).get("count") for r in results)]
+    for name in names:
+        cells = []
+        for r in results:
+            stage = r["stages"].get(name)
+            if not stage or not stage["count"]:
+                cells.append("-".rjust(width))
+                continue
+            cell = "%d / %d" % (stage["avg"], stage["max"])
+            if baseline is not None and r is not baseline:
+                base = baseline["stages"].get(name)
+                if base and base["avg"]:
+                    change = 100.0 * (stage["avg"] - base["avg"]) / base["avg"]
+                    cell += " %+.0f%%" % change
+                    if tolerance is not None and change > tolerance:
+                        regressions.append((r["label"], name, change))
+                        cell += "!"
+            cells.append(cell.rjust(width))
+        print(name.ljust(14) + "".join(cells))
+    print("(average / maximum CPU cycles%s)" % (", change of the average" if baseline else ""))
+    return regressions
+
+
+def compare(args):
+    results = []
+    for path in args.results:
+        with open(path) as f:
+            results.append(json.load(f))
+    regressions = print_table(results, results[0], args.tolerance)
+    for label, name, change in regressions:
+        print("%s: %s %+.1f%% over %s" % (label, name, change, results[0]["label"]), file=sys.stderr)
+    if regressions:
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    run_parser = commands.add_parser("run", help="measure and save the results")
+    run_parser.add_argument("--device", help="J-Link device name, for the board already programmed")
+    run_parser.add_argument("--target", action="append",
+                            help="TARGET[:DEVICE] to build, program and measure, may be repeated")
+    run_parser.add_argument("--defines", help="extra DEFINES of the benchmark build (STAGE_BENCHMARK_DEFINES)")
+    run_parser.add_argument("--make", default="make", help="make executable")
+    run_parser.add_argument("--serial", type=int, help="J-Link serial number")
+    run_parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                            help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    run_parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    run_parser.add_argument("--timeout", type=float, default=60.0, help="seconds to wait for the report")
+    run_parser.add_argument("--input", help="decode a captured binary file instead of reading over J-Link")
+    run_parser.add_argument("--label", help="name of the result, the target name if omitted")
+    run_parser.add_argument("--output-dir", help="directory for the LABEL.json files, the current one if omitted")
+
+    compare_parser = commands.add_parser("compare", help="compare saved results")
+    compare_parser.add_argument("results", nargs="+", help="JSON results, the first one is the baseline")
+    compare_parser.add_argument("--tolerance", type=float,
+                                help="fail if the average of a stage grew by more than this percentage")
+
+    args = parser.parse_args()
+    if args.command == "run":
+        run(args)
+    else:
+        compare(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Host writer for batched tuner parameter writes.
+
+The firmware built with RTT_TUNER_BATCH_EN=1u accepts, besides the regular
+16-byte command packets, a batch of writes to the tuner data on the tuner
+down-buffer. The batch is checked as a whole with one CRC and applied between
+two scans, so a full parameter set takes effect at once instead of one
+command per tuner run.
+
+Batch layout: 0x0D 0x0B header, 8-bit write count, reserved byte, then per
+write a 16-bit byte offset into the tuner data, an 8-bit size and the data,
+then a CRC-16/CCITT-FALSE of all bytes before it and the 0x00 0xFF 0xFF tail.
+All values are little-endian. A batch is at most RTT_TUNER_DOWN_BUF_SIZE
+bytes long; larger parameter sets are split into several batches, each of
+which is applied on its own.
+
+Requires pylink-square unless --output is used.
+
+Example:
+    tools/tuner_batch.py --device CY8C4147AZI-S475 --write 0x4A 2 120 --write 0x4C 2 80
+    tools/tuner_batch.py --device CY8C4147AZI-S475 --image tuned.bin --base current.bin
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+TUNER_CHANNEL = 1
+
+HEADER = b"\x0d\x0b"
+TAIL = b"\x00\xff\xff"
+BATCH_OVERHEAD = 4 + 2 + len(TAIL)
+WRITE_HEADER = 3
+MAX_WRITE_SIZE = 255
+MAX_WRITES = 255
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as calculated by the firmware."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode_batch(writes):
+    """Encodes a list of (offset, data) as one batch."""
+    body = HEADER + bytes([len(writes), 0])
+    for offset, data in writes:
+        body += struct.pack("<HB", offset, len(data)) + bytes(data)
+    return body + struct.pack("<H", crc16(body)) + TAIL
+
+
+def encode_batches(writes, max_size):
+    """Splits a list of (offset, data) into batches of at most max_size bytes."""
+    chunk_size = min(MAX_WRITE_SIZE, max_size - BATCH_OVERHEAD - WRITE_HEADER)
+    if chunk_size <= 0:
+        sys.exit("--max-size %d cannot hold a write" % max_size)
+
+    batches = []
+    current = []
+    size = BATCH_OVERHEAD
+    for offset, data in writes:
+        for start in range(0, len(data), chunk_size):
+            chunk = data[start:start + chunk_size]
+            needed = WRITE_HEADER + len(chunk)
+            if current and (size + needed > max_size or len(current) == MAX_WRITES):
+                batches.append(encode_batch(current))
+                current = []
+                size = BATCH_OVERHEAD
+            current.append((offset + start, chunk))
+            size += needed
+    if current:
+        batches.append(encode_batch(current))
+    return batches
+
+
+def changed_writes(image, base):
+    """Returns (offset, data) for every byte range in which image and base
+    differ, merging ranges closer than a write header."""
+    writes = []
+    start = None
+    last = None
+    for i, (new, old) in enumerate(zip(image, base)):
+        if new == old:
+            continue
+        if start is not None and i - last > WRITE_HEADER:
+            writes.append((start, image[start:last + 1]))
+            start = None
+        if start is None:
+            start = i
+        last = i
+    if start is not None:
+        writes.append((start, image[start:last + 1]))
+    return writes
+
+
+def write_jlink(args, batches):
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_down_buffers() > TUNER_CHANNEL:
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        for batch in batches:
+            # The down-buffer may have less room than a batch, the firmware
+            # collects the rest with the following tuner runs
+            sent = 0
+            deadline = time.monotonic() + 5.0
+            while sent < len(batch):
+                sent += jlink.rtt_write(TUNER_CHANNEL, list(batch[sent:]))
+                if time.monotonic() > deadline:
+                    sys.exit("The firmware does not read the tuner down-buffer")
+                if sent < len(batch):
+                    time.sleep(0.001)
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--write", nargs=3, action="append", default=[], metavar=("OFFSET", "SIZE", "VALUE"),
+                        help="write VALUE as a SIZE-byte integer at byte OFFSET of the tuner data")
+    parser.add_argument("--image", help="tuner data image to write")
+    parser.add_argument("--base", help="tuner data image on the target, only the bytes --image changes are written")
+    parser.add_argument("--max-size", type=int, default=256, help="RTT_TUNER_DOWN_BUF_SIZE of the firmware")
+    parser.add_argument("--output", help="write the batches to this file instead of sending them")
+    parser.add_argument("--device", help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    args = parser.parse_args()
+    if not args.output and not args.device:
+        parser.error("either --output or --device is required")
+    if args.base and not args.image:
+        parser.error("--base requires --image")
+
+    writes = []
+    for offset, size, value in args.write:
+        offset, size, value = int(offset, 0), int(size, 0), int(value, 0)
+        if value < 0:
+            value += 1 << (8 * size)
+        writes.append((offset, value.to_bytes(size, "little")))
+    if args.image:
+        with open(args.image, "rb") as f:
+            image = f.read()
+        if args.base:
+            with open(args.base, "rb") as f:
+                writes += changed_writes(image, f.read())
+        else:
+            writes.append((0, image))
+    if not writes:
+        sys.exit("nothing to write, use --write or --image")
+
+    batches = encode_batches(writes, args.max_size)
+    print("%d writes in %d batches, %d bytes" % (len(writes), len(batches), sum(len(b) for b in batches)))
+    if args.output:
+        with open(args.output, "wb") as f:
+            for batch in batches:
+                f.write(batch)
+    else:
+        write_jlink(args, batches)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Host reader for the direct tuner mode.
+
+The firmware built with RTT_TUNER_DIRECT_EN=1u does not copy the tuner data
+into a frame. Its tuner up-buffer holds a descriptor with the address and
+size of cy_capsense_tuner and a sequence counter that is odd while the
+firmware updates the data. This script reads the descriptor over RTT once,
+then reads the live tuner data straight from memory: sequence, data,
+sequence. A read is kept only if both sequence values are equal and even
+and differ from the previous kept read, so torn reads and duplicate polls
+are discarded.
+
+Descriptor layout: 0x0D 0x0A header, 2 reserved bytes, 32-bit sequence,
+32-bit data address, 32-bit data size, 32-bit address of the sequence,
+0x00 0xFF 0xFF tail. All values are little-endian.
+
+Requires pylink-square.
+
+Example:
+    tools/tuner_direct.py --device CY8C4147AZI-S475 --duration 10 --output frames.bin
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+TUNER_CHANNEL = 1
+
+HEADER = b"\x0d\x0a"
+TAIL = b"\x00\xff\xff"
+DESCRIPTOR = struct.Struct("<2s2xIIII3s")
+
+
+def parse_descriptor(data):
+    """Returns (sequence, data address, data size, sequence address) of the
+    last complete descriptor in data, or None."""
+    start = data.rfind(HEADER, 0, len(data) - DESCRIPTOR.size + len(HEADER))
+    while start >= 0:
+        _, sequence, address, size, seq_address, tail = DESCRIPTOR.unpack_from(data, start)
+        if tail == TAIL:
+            return sequence, address, size, seq_address
+        start = data.rfind(HEADER, 0, start)
+    return None
+
+
+class Reader:
+    """Keeps consistent, new snapshots of the tuner data."""
+
+    def __init__(self, read32, read8, address, size, seq_address):
+        self.read32 = read32
+        self.read8 = read8
+        self.address = address
+        self.size = size
+        self.seq_address = seq_address
+        self.last = None
+        self.frames = 0
+        self.torn = 0
+        self.duplicates = 0
+
+    def poll(self):
+        """Returns (sequence, data) of a new consistent snapshot, or None."""
+        before = self.read32(self.seq_address)
+        if before & 1:
+            self.torn += 1
+            return None
+        data = bytes(self.read8(self.address, self.size))
+        after = self.read32(self.seq_address)
+        if after != before:
+            self.torn += 1
+            return None
+        if before == self.last:
+            self.duplicates += 1
+            return None
+        self.last = before
+        self.frames += 1
+        return before, data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--device", required=True, help="J-Link device name")
+    parser.add_argument("--serial", type=int, help="J-Link serial number")
+    parser.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                        help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    parser.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    parser.add_argument("--duration", type=float, default=0.0, help="seconds to read, until Ctrl+C if 0")
+    parser.add_argument("--output", help="append each snapshot as 32-bit sequence and tuner data to this file")
+    args = parser.parse_args()
+
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    output = open(args.output, "wb") if args.output else None
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait for the descriptor on the tuner channel
+        descriptor = None
+        received = b""
+        deadline = time.monotonic() + 5.0
+        while descriptor is None:
+            try:
+                received += bytes(jlink.rtt_read(TUNER_CHANNEL, 256))
+                descriptor = parse_descriptor(received)
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("No direct mode descriptor found, build with RTT_TUNER_DIRECT_EN=1u")
+            time.sleep(0.01)
+        jlink.rtt_stop()
+
+        _, address, size, seq_address = descriptor
+        print("tuner data: %d bytes at 0x%08X, sequence at 0x%08X" % (size, address, seq_address))
+        reader = Reader(lambda a: jlink.memory_read32(a, 1)[0], jlink.memory_read8, address, size, seq_address)
+
+        start = time.monotonic()
+        report = start + 1.0
+        try:
+            while args.duration <= 0 or time.monotonic() - start < args.duration:
+                snapshot = reader.poll()
+                if snapshot and output:
+                    output.write(struct.pack("<I", snapshot[0]) + snapshot[1])
+                now = time.monotonic()
+                if now >= report:
+                    print("%8.1f s  %6d frames  %5.1f fps  %d torn  %d duplicate polls"
+                          % (now - start, reader.frames, reader.frames / (now - start),
+                             reader.torn, reader.duplicates), flush=True)
+                    report += 1.0
+        except KeyboardInterrupt:
+            pass
+    finally:
+        if output:
+            output.close()
+        jlink.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,344 @@
+#!/usr/bin/env python3
+"""Compact tuner frame generator and decoder.
+
+generate: reads the CAPSENSE configuration (design.cycapsense) of the target
+and writes the frame descriptor used by the firmware built with
+RTT_TUNER_COMPACT_EN=1u, as a C header, and the same descriptor as JSON for
+the host. The descriptor lists only the per-scan fields of the widgets and
+sensors in the design: widget status, slider and touchpad positions, and the
+raw count, baseline, difference count and status of every sensor. The make
+build runs this step before compiling when COMPACT_FRAME=1.
+
+decode: reads compact frames from the tuner channel over J-Link and prints
+the fields listed in the JSON descriptor. With --slow, the calibration frames
+of a firmware built with RTT_TUNER_MULTIRATE_EN=1u are read from the slow
+channel as well, and the byte ranges of the tuner data that changed since
+the previous calibration frame are reported.
+
+Frame layout: 0x0D 0x0A header, 16-bit frame ID, timestamp (streaming
+transport only), the fields in descriptor order, 0x00 0xFF 0xFF tail. All
+values are little-endian. The frame ID is a CRC of the descriptor, so a
+frame never gets decoded against a descriptor of another design.
+
+Calibration frame layout: 0x0D 0x0A header, 16-bit frame ID, 16-bit size of
+the tuner data, the complete tuner data, 0x00 0xFF 0xFF tail.
+
+Requires pylink-square for decode.
+
+Example:
+    tools/tuner_frame.py generate --target CY8CKIT-149 --output build/generated
+    tools/tuner_frame.py decode --device CY8C4147AZI-S475 --descriptor build/generated/rtt_tuner_frame.json
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+import time
+import xml.etree.ElementTree as ElementTree
+
+TUNER_CHANNEL = 1
+SLOW_CHANNEL = 5
+
+HEADER = b"\x0d\x0a"
+TAIL = b"\x00\xff\xff"
+
+REPO_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+NS = {"cy": "http://cypress.com/xsd/cyconfigurationfile_v1"}
+
+# Fields of the tuner structure members: name, C member, size in bytes
+WIDGET_FIELDS = [("status", "status", 1)]
+SENSOR_FIELDS = [("raw", "raw", 2), ("bsln", "bsln", 2), ("diff", "diff", 2), ("status", "status", 1)]
+POSITION_FIELDS = {"slider": [("x", "x", 2)], "touchpad": [("x", "x", 2), ("y", "y", 2)]}
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def find_design(target, config):
+    for path in (os.path.join(REPO_DIR, "bsps", "TARGET_APP_" + target, config, "design.cycapsense"),
+                 os.path.join(REPO_DIR, "templates", "TARGET_" + target, config, "design.cycapsense")):
+        if os.path.isfile(path):
+            return path
+    sys.exit("design.cycapsense for %s not found, use --design" % target)
+
+
+def read_widgets(path):
+    """Returns (name, type, number of sensors) for every widget, in ID order."""
+    widgets = []
+    for widget in ElementTree.parse(path).getroot().iterfind("cy:Widgets/cy:Widget", NS):
+        kinds = [e.get("kind") for e in widget.iterfind("cy:Electrodes/cy:Electrode", NS)]
+        if "Rx" in kinds or "Tx" in kinds:
+            sensors = kinds.count("Rx") * kinds.count("Tx")
+        else:
+            sensors = len(kinds)
+        widgets.append((widget.get("id"), widget.get("type"), sensors))
+    if not widgets:
+        sys.exit("%s: no widgets found" % path)
+    return widgets
+
+
+def build_descriptor(widgets):
+    """Lists the frame fields as (name, C member, size)."""
+    fields = []
+    for wd_id, (name, wd_type, _) in enumerate(widgets):
+        for field, member, size in WIDGET_FIELDS:
+            fields.append(("%s.%s" % (name, field), "widgetContext[%d].%s" % (wd_id, member), size))
+        kind = "touchpad" if "TOUCHPAD" in wd_type else "slider" if "SLIDER" in wd_type else None
+        for field, member, size in POSITION_FIELDS.get(kind, []):
+            fields.append(("%s.%s" % (name, field), "position_%s[0].%s" % (name, member), size))
+
+    sns_id = 0
+    for name, _, sensors in widgets:
+        for sns in range(sensors):
+            for field, member, size in SENSOR_FIELDS:
+                fields.append(("%s.Sns%d.%s" % (name, sns, field), "sensorContext[%d].%s" % (sns_id, member), size))
+            sns_id += 1
+    return fields
+
+
+def write_header(path, design, frame_id, widgets, fields):
+    size = sum(f[2] for f in fields)
+    lines = [
+        "/* Generated by tools/tuner_frame.py from %s. Do not edit. */" % os.path.relpath(design, REPO_DIR).replace(os.sep, "/"),
+        "",
+        "#ifndef RTT_TUNER_FRAME_H",
+        "#define RTT_TUNER_FRAME_H",
+        "",
+        "#include <stddef.h>",
+        "#include \"cycfg_capsense.h\"",
+        "",
+        "#define RTT_TUNER_FRAME_ID          (0x%04Xu)" % frame_id,
+        "#define RTT_TUNER_FRAME_FIELDS      (%du)" % len(fields),
+        "#define RTT_TUNER_FRAME_SIZE        (%du)" % size,
+        "",
+        "/* {offset in cy_capsense_tuner, size} of each field, in frame order */",
+        "#define RTT_TUNER_FIELD(member)     { (uint16_t)offsetof(cy_capsense_tuner_t, member), (uint8_t)sizeof(cy_capsense_tuner.member) }",
+        "",
+        "#define RTT_TUNER_FRAME_DESCRIPTOR  { \\",
+    ]
+    for i, (name, member, _) in enumerate(fields):
+        sep = "," if i + 1 < len(fields) else " "
+        lines.append("    RTT_TUNER_FIELD(%s)%s /* %s */ \\" % (member, sep, name))
+    lines.append("}")
+    lines.append("")
+    lines.append("/* The descriptor must match the generated CAPSENSE configuration */")
+    lines.append("_Static_assert(CY_CAPSENSE_WIDGET_COUNT == %du, \"Descriptor out of date, rebuild with COMPACT_FRAME=1\");" % len(widgets))
+    lines.append("_Static_assert(CY_CAPSENSE_SENSOR_COUNT == %du, \"Descriptor out of date, rebuild with COMPACT_FRAME=1\");" % sum(w[2] for w in widgets))
+    lines.append("")
+    lines.append("/* The host decodes the fields with these sizes */")
+    checked = set()
+    for name, member, size in fields:
+        kind = re.sub(r"\[\d+\]", "[0]", member)
+        if kind not in checked:
+            checked.add(kind)
+            lines.append("_Static_assert(sizeof(cy_capsense_tuner.%s) == %du, \"%s\");" % (kind, size, name.split(".")[-1]))
+    lines += ["", "#endif /* RTT_TUNER_FRAME_H */", ""]
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+def generate(args):
+    design = args.design or find_design(args.target, args.config)
+    widgets = read_widgets(design)
+    fields = build_descriptor(widgets)
+    listing = [{"name": name, "size": size} for name, _, size in fields]
+    frame_id = crc16(json.dumps(listing, sort_keys=True).encode())
+
+    offset = 0
+    for field in listing:
+        field["offset"] = offset
+        offset += field["size"]
+
+    os.makedirs(args.output, exist_ok=True)
+    write_header(os.path.join(args.output, "rtt_tuner_frame.h"), design, frame_id, widgets, fields)
+    with open(os.path.join(args.output, "rtt_tuner_frame.json"), "w", newline="\n") as f:
+        json.dump({"frame_id": frame_id, "size": offset, "fields": listing}, f, indent=2)
+        f.write("\n")
+    print("%s: %d fields, %d bytes, frame ID 0x%04X" % (os.path.basename(design), len(fields), offset, frame_id))
+
+
+class FrameParser:
+    """Splits the tuner byte stream into compact frames."""
+
+    def __init__(self, descriptor, timestamp):
+        self.frame_id = descriptor["frame_id"]
+        self.payload = descriptor["size"]
+        self.prefix = len(HEADER) + 2 + (4 if timestamp else 0)
+        self.length = self.prefix + self.payload + len(TAIL)
+        self.timestamp = timestamp
+        self.buffer = b""
+        self.sync_errors = 0
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        while len(self.buffer) >= self.length:
+            frame = self.buffer[:self.length]
+            frame_id, = struct.unpack_from("<H", frame, len(HEADER))
+            if (not frame.startswith(HEADER)) or (not frame.endswith(TAIL)) or frame_id != self.frame_id:
+                self.buffer = self.buffer[1:]
+                self.sync_errors += 1
+                continue
+            timestamp = struct.unpack_from("<I", frame, 4)[0] if self.timestamp else None
+            frames.append((timestamp, frame[self.prefix:self.prefix + self.payload]))
+            self.buffer = self.buffer[self.length:]
+        return frames
+
+
+class SlowFrameParser:
+    """Splits the slow channel byte stream into calibration frames."""
+
+    PREFIX = len(HEADER) + 4
+
+    def __init__(self, descriptor):
+        self.frame_id = descriptor["frame_id"]
+        self.buffer = b""
+        self.sync_errors = 0
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        while len(self.buffer) >= self.PREFIX:
+            frame_id, size = struct.unpack_from("<HH", self.buffer, len(HEADER))
+            if (not self.buffer.startswith(HEADER)) or frame_id != self.frame_id:
+                self.buffer = self.buffer[1:]
+                self.sync_errors += 1
+                continue
+            length = self.PREFIX + size + len(TAIL)
+            if len(self.buffer) < length:
+                break
+            if not self.buffer[:length].endswith(TAIL):
+                self.buffer = self.buffer[1:]
+                self.sync_errors += 1
+                continue
+            frames.append(self.buffer[self.PREFIX:self.PREFIX + size])
+            self.buffer = self.buffer[length:]
+        return frames
+
+
+def changed_ranges(old, new):
+    """Returns the (offset, length) of each run of bytes that differ."""
+    ranges = []
+    start = None
+    for offset in range(len(new)):
+        differs = offset >= len(old) or old[offset] != new[offset]
+        if differs and start is None:
+            start = offset
+        elif not differs and start is not None:
+            ranges.append((start, offset - start))
+            start = None
+    if start is not None:
+        ranges.append((start, len(new) - start))
+    return ranges
+
+
+def decode_fields(descriptor, payload):
+    values = {}
+    for field in descriptor["fields"]:
+        fmt = "<B" if field["size"] == 1 else "<H"
+        values[field["name"]], = struct.unpack_from(fmt, payload, field["offset"])
+    return values
+
+
+def decode(args):
+    import pylink
+
+    with open(args.descriptor) as f:
+        descriptor = json.load(f)
+    parser = FrameParser(descriptor, args.stream)
+    slow_parser = SlowFrameParser(descriptor)
+    calibration = None
+    names = [field["name"] for field in descriptor["fields"]
+             if not args.fields or any(field["name"].startswith(p) for p in args.fields)]
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    try:
+        jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+        jlink.set_speed(args.swd_speed)
+        jlink.connect(args.device)
+        jlink.rtt_start(args.rtt_address)
+
+        # Wait until J-Link has found the RTT control block
+        deadline = time.monotonic() + 5.0
+        while True:
+            try:
+                if jlink.rtt_get_num_up_buffers() > (SLOW_CHANNEL if args.slow else TUNER_CHANNEL):
+                    break
+            except pylink.errors.JLinkRTTException:
+                pass
+            if time.monotonic() > deadline:
+                sys.exit("RTT control block not found")
+            time.sleep(0.01)
+
+        print(("timestamp  " if args.stream else "") + "  ".join(names))
+        try:
+            while True:
+                data = jlink.rtt_read(TUNER_CHANNEL, 4096)
+                for timestamp, payload in parser.feed(bytes(data)):
+                    values = decode_fields(descriptor, payload)
+                    row = ["%d" % values[name] for name in names]
+                    print((("%10d " % timestamp) if args.stream else "") + "  ".join(row), flush=True)
+                if args.slow:
+                    for data in slow_parser.feed(bytes(jlink.rtt_read(SLOW_CHANNEL, 4096))):
+                        if calibration is None:
+                            print("# calibration: %d bytes" % len(data), flush=True)
+                        else:
+                            ranges = changed_ranges(calibration, data)
+                            if ranges:
+                                print("# calibration changed: " + " ".join("%d+%d" % r for r in ranges), flush=True)
+                        calibration = data
+                if args.poll_ms > 0:
+                    time.sleep(args.poll_ms / 1000.0)
+        except KeyboardInterrupt:
+            pass
+        jlink.rtt_stop()
+    finally:
+        jlink.close()
+    if parser.sync_errors + slow_parser.sync_errors:
+        print("%d bytes skipped to resynchronize" % (parser.sync_errors + slow_parser.sync_errors), file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    gen = sub.add_parser("generate", help="write the frame descriptor for a design")
+    gen.add_argument("--target", default="CY8CKIT-149", help="kit whose design is used (make variable TARGET)")
+    gen.add_argument("--config", default="config", help="design directory of the kit (make variable CAPSENSE_CONFIG)")
+    gen.add_argument("--design", help="design.cycapsense file, found from --target and --config if omitted")
+    gen.add_argument("--output", required=True, help="directory for rtt_tuner_frame.h and rtt_tuner_frame.json")
+
+    dec = sub.add_parser("decode", help="print compact frames read over J-Link")
+    dec.add_argument("--descriptor", required=True, help="rtt_tuner_frame.json of the firmware build")
+    dec.add_argument("--device", required=True, help="J-Link device name")
+    dec.add_argument("--serial", type=int, help="J-Link serial number")
+    dec.add_argument("--rtt-address", type=lambda v: int(v, 0),
+                     help="RTT control block address (RTT_CB_ADDRESS), searched in RAM if omitted")
+    dec.add_argument("--swd-speed", type=int, default=4000, help="J-Link interface speed in kHz")
+    dec.add_argument("--stream", action="store_true", help="firmware uses the streaming transport (RTT_USE_FAST_RTT=0)")
+    dec.add_argument("--poll-ms", type=float, default=10.0, help="delay between two reads")
+    dec.add_argument("--slow", action="store_true", help="also read the calibration frames (RTT_TUNER_MULTIRATE_EN=1u)")
+    dec.add_argument("--fields", nargs="+", help="only print fields starting with these names, e.g. LinearSlider0")
+
+    args = parser.parse_args()
+    if args.command == "generate":
+        generate(args)
+    else:
+        decode(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,161 @@
+/******************************************************************************
+ * File Name: touch_events.c
+ *
+ * Description: This file contains the touch event output, which compares the
+ * widget status after each scan cycle and reports the changes on
+ * an RTT up-buffer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "touch_events.h"
+
+#if (0u != TOUCH_EVENTS_EN)
+#include "timestamp.h"
+#include "slider_filter.h"
+#include "SEGGER_RTT/RTT/SEGGER_RTT.h"
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+RTT_CHANNEL_BUFFER(touch_events_up_buf, TOUCH_EVENTS_BUF_EVENTS * sizeof(touch_event_t));
+static uint8_t touch_events_sequence = 0u;
+
+/* Widget state reported last */
+static bool touch_active[CY_CAPSENSE_WIDGET_COUNT];
+static uint16_t touch_position[CY_CAPSENSE_WIDGET_COUNT];
+
+
+/*******************************************************************************
+ * Function Name: touch_events_init
+ ********************************************************************************
+ * Summary:
+ *  Configures the touch event up-buffer. SEGGER_RTT_Init() must have been
+ *  called before.
+ *
+ *******************************************************************************/
+void touch_events_init(void)
+{
+    RTT_CHANNEL_CONFIG_UP(TOUCH_EVENTS_RTT_CHANNEL, "events", touch_events_up_buf, RTT_CHANNEL_RECORD_FLAGS);
+}
+
+
+/*******************************************************************************
+ * Function Name: touch_events_emit
+ ********************************************************************************
+ * Summary:
+ *  Writes one event record. The record is dropped if the up-buffer is full,
+ *  which the host detects from the sequence number.
+ *
+ * Parameters:
+ *  type: event type
+ *  widget_id: widget the event belongs to
+ *  value: position, or 0 for buttons
+ *
+ *******************************************************************************/
+static void touch_events_emit(touch_event_type_t type, uint32_t widget_id, uint16_t value)
+{
+    touch_event_t event;
+
+    event.sync = TOUCH_EVENT_SYNC;
+    event.type = (uint8_t)type;
+    event.widget_id = (uint8_t)widget_id;
+    event.sequence = touch_events_sequence++;
+    event.value = value;
+    event.time = (uint16_t)(timestamp_get() >> 16u);
+
+    RTT_CHANNEL_WRITE(TOUCH_EVENTS_RTT_CHANNEL, &event, sizeof(event));
+}
+
+
+/*******************************************************************************
+ * Function Name: touch_events_update
+ ********************************************************************************
+ * Summary:
+ *  Compares the status of every widget with the last reported state and emits
+ *  an event for each change. Call once per scan cycle after all widgets are
+ *  processed. Only the first touch position of a slider is reported, after
+ *  the slider filter with SLIDER_FILTER_EN.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void touch_events_update(const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_touch_t * touch;
+    uint16_t position;
+    bool active;
+    uint32_t widget_id;
+
+    for (widget_id = 0u; widget_id < CY_CAPSENSE_WIDGET_COUNT; widget_id++)
+    {
+        active = (0u != Cy_CapSense_IsWidgetActive(widget_id, context));
+        position = touch_position[widget_id];
+
+        if (active && (CY_CAPSENSE_WD_LINEAR_SLIDER_E == context->ptrWdConfig[widget_id].wdType))
+        {
+            touch = Cy_CapSense_GetTouchInfo(widget_id, context);
+            if (0u != touch->numPosition)
+            {
+#if (0u != SLIDER_FILTER_EN)
+                position = slider_filter_get_position(widget_id);
+#else
+                position = touch->ptrPosition[0u].x;
+#endif
+            }
+        }
+
+        if (active != touch_active[widget_id])
+        {
+            touch_events_emit(active ? TOUCH_EVENT_TOUCH : TOUCH_EVENT_RELEASE, widget_id, position);
+        }
+        else if (active && (position != touch_position[widget_id]))
+        {
+            touch_events_emit(TOUCH_EVENT_POSITION, widget_id, position);
+        }
+
+        touch_active[widget_id] = active;
+        touch_position[widget_id] = position;
+    }
+}
+#endif /* TOUCH_EVENTS_EN */
+
+
+/* [] END OF FILE */
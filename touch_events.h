@@ -0,0 +1,100 @@
+/******************************************************************************
+ * File Name: touch_events.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the touch event output, which reports button and slider changes
+ * as small fixed-size records on an RTT up-buffer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TOUCH_EVENTS_H
+#define TOUCH_EVENTS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Report touch events on their own RTT channel, next to the tuner stream */
+#ifndef TOUCH_EVENTS_EN
+#define TOUCH_EVENTS_EN                 (0u)
+#endif
+
+/* Number of events the up-buffer can hold */
+#ifndef TOUCH_EVENTS_BUF_EVENTS
+#define TOUCH_EVENTS_BUF_EVENTS         (32u)
+#endif
+
+#define TOUCH_EVENT_SYNC                (0xA5u)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    TOUCH_EVENT_RELEASE,    /* Widget became inactive, value: last position */
+    TOUCH_EVENT_TOUCH,      /* Widget became active, value: position */
+    TOUCH_EVENT_POSITION    /* Slider position changed, value: new position */
+} touch_event_type_t;
+
+/* Event record, all fields are little-endian. Buttons report position 0. */
+typedef struct
+{
+    uint8_t  sync;          /* TOUCH_EVENT_SYNC */
+    uint8_t  type;          /* touch_event_type_t */
+    uint8_t  widget_id;
+    uint8_t  sequence;      /* Incremented per event, gaps are dropped events */
+    uint16_t value;
+    uint16_t time;          /* Bits 31:16 of the CPU cycle timestamp */
+} touch_event_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != TOUCH_EVENTS_EN)
+void touch_events_init(void);
+void touch_events_update(const cy_stc_capsense_context_t * context);
+#endif
+
+#endif /* TOUCH_EVENTS_H */
+
+
+/* [] END OF FILE */
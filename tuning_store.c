@@ -0,0 +1,291 @@
+/******************************************************************************
+ * File Name: tuning_store.c
+ *
+ * Description: This file contains the tuning profile store. On request, the
+ * widget contexts, which hold the tuned thresholds and the calibrated
+ * modulator IDAC values, and the compensation IDAC value of every sensor are
+ * written to reserved flash rows. At startup, a valid profile for the same
+ * CAPSENSE configuration is copied back before the CAPSENSE is enabled.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "tuning_store.h"
+
+#if (0u != TUNING_STORE_EN)
+#include <stddef.h>
+#include <string.h>
+
+/* Log lines of this file are told apart from those of main.c */
+#define DEFERRED_LOG_MODULE             (1u)
+#include "deferred_log.h"
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Profile layout in flash */
+typedef struct
+{
+    uint32_t magic;             /* TUNING_STORE_MAGIC */
+    uint16_t config_id;         /* CAPSENSE configuration the profile was saved for */
+    uint16_t size;              /* sizeof(tuning_store_record_t) */
+    uint16_t crc;               /* CRC-16 of the fields below */
+    uint16_t reserved;
+    cy_stc_capsense_widget_context_t widget[CY_CAPSENSE_WIDGET_COUNT];
+    uint8_t  idac_comp[CY_CAPSENSE_SENSOR_COUNT];
+} tuning_store_record_t;
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TUNING_STORE_ROWS               ((sizeof(tuning_store_record_t) + CY_FLASH_SIZEOF_ROW - 1u) / CY_FLASH_SIZEOF_ROW)
+#define TUNING_STORE_DATA_OFFSET        (offsetof(tuning_store_record_t, widget))
+
+/* Reserved flash rows, outside the firmware image */
+#define TUNING_STORE_PROFILE            ((const tuning_store_record_t *)(uintptr_t)TUNING_STORE_ADDRESS)
+
+_Static_assert((TUNING_STORE_ADDRESS % CY_FLASH_SIZEOF_ROW) == 0u, "TUNING_STORE_ADDRESS must be at the start of a flash row");
+_Static_assert((TUNING_STORE_ADDRESS >= CY_FLASH_BASE) &&
+               ((TUNING_STORE_ROWS * CY_FLASH_SIZEOF_ROW) <= (CY_FLASH_BASE + CY_FLASH_SIZE - TUNING_STORE_ADDRESS)),
+               "The tuning profile does not fit between TUNING_STORE_ADDRESS and the end of flash");
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+
+/* Row staging buffer of Cy_Flash_WriteRow() */
+static uint32_t tuning_store_row_buf[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+
+static tuning_store_request_t tuning_store_pending = TUNING_STORE_REQUEST_NONE;
+
+
+/*******************************************************************************
+ * Function Name: tuning_store_crc16
+ ********************************************************************************
+ * Summary:
+ *  Continues the CRC-16/CCITT-FALSE calculation over the data, starting with
+ *  0xFFFF. Runs once at startup and per save, so it is calculated bit by bit
+ *  without a table.
+ *
+ *******************************************************************************/
+static uint32_t tuning_store_crc16(uint32_t crc, const uint8_t * data, uint32_t length)
+{
+    uint32_t bit;
+
+    while (0u != length--)
+    {
+        crc ^= (uint32_t)*data++ << 8u;
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? ((crc << 1u) ^ 0x1021u) : (crc << 1u);
+        }
+        crc &= 0xFFFFu;
+    }
+
+    return crc;
+}
+
+
+/*******************************************************************************
+ * Function Name: tuning_store_restore
+ ********************************************************************************
+ * Summary:
+ *  Copies a valid profile from flash to the CAPSENSE context. Call after
+ *  Cy_CapSense_Init() and before Cy_CapSense_Enable(). The touch state of the
+ *  widgets is not part of the profile. A profile saved for another CAPSENSE
+ *  configuration is stale and is not restored.
+ *
+ * Return:
+ *  true if a profile has been restored
+ *
+ *******************************************************************************/
+bool tuning_store_restore(cy_stc_capsense_context_t * context)
+{
+    const tuning_store_record_t * profile = TUNING_STORE_PROFILE;
+    cy_stc_capsense_touch_t touch;
+    uint8_t status;
+    uint32_t sensor = 0u;
+    uint32_t i;
+    uint32_t j;
+
+    if ((TUNING_STORE_MAGIC != profile->magic) ||
+        (sizeof(tuning_store_record_t) != profile->size) ||
+        (profile->crc != tuning_store_crc16(0xFFFFu, (const uint8_t *)profile + TUNING_STORE_DATA_OFFSET,
+                                            sizeof(tuning_store_record_t) - TUNING_STORE_DATA_OFFSET)))
+    {
+        return false;
+    }
+
+    if (context->ptrCommonContext->configId != profile->config_id)
+    {
+        DEFERRED_LOG2("Tuning profile of configuration 0x%04X is stale, current 0x%04X",
+                      profile->config_id, context->ptrCommonContext->configId);
+        return false;
+    }
+
+    for (i = 0u; i < CY_CAPSENSE_WIDGET_COUNT; i++)
+    {
+        touch = context->ptrWdContext[i].wdTouch;
+        status = context->ptrWdContext[i].status;
+        context->ptrWdContext[i] = profile->widget[i];
+        context->ptrWdContext[i].wdTouch = touch;
+        context->ptrWdContext[i].status = status;
+
+        for (j = 0u; j < context->ptrWdConfig[i].numSns; j++)
+        {
+            context->ptrWdConfig[i].ptrSnsContext[j].idacComp = profile->idac_comp[sensor++];
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ * Function Name: tuning_store_request
+ ********************************************************************************
+ * Summary:
+ *  Requests that the profile is saved or erased by the next
+ *  tuning_store_process() call. Called by the tuner for the
+ *  RTT_TUNER_CMD_SAVE_PROFILE and RTT_TUNER_CMD_ERASE_PROFILE commands,
+ *  and may be called by the application.
+ *
+ *******************************************************************************/
+void tuning_store_request(tuning_store_request_t request)
+{
+    tuning_store_pending = request;
+}
+
+
+/*******************************************************************************
+ * Function Name: tuning_store_write
+ ********************************************************************************
+ * Summary:
+ *  Writes a profile image to the reserved flash rows.
+ *
+ * Return:
+ *  true if all rows have been written
+ *
+ *******************************************************************************/
+static bool tuning_store_write(const tuning_store_record_t * record)
+{
+    uint32_t row;
+    uint32_t offset;
+    uint32_t length;
+
+    for (row = 0u; row < TUNING_STORE_ROWS; row++)
+    {
+        offset = row * CY_FLASH_SIZEOF_ROW;
+        length = sizeof(tuning_store_record_t) - offset;
+        if (length > CY_FLASH_SIZEOF_ROW)
+        {
+            length = CY_FLASH_SIZEOF_ROW;
+        }
+
+        memset(tuning_store_row_buf, 0, sizeof(tuning_store_row_buf));
+        if (NULL != record)
+        {
+            memcpy(tuning_store_row_buf, (const uint8_t *)record + offset, length);
+        }
+
+        if (CY_FLASH_DRV_SUCCESS != Cy_Flash_WriteRow((uint32_t)TUNING_STORE_ADDRESS + offset, tuning_store_row_buf))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+ * Function Name: tuning_store_process
+ ********************************************************************************
+ * Summary:
+ *  Saves or erases the profile if requested. Call from the main loop while
+ *  the CAPSENSE hardware is idle; the CPU is stalled while each flash row is
+ *  written.
+ *
+ *******************************************************************************/
+void tuning_store_process(const cy_stc_capsense_context_t * context)
+{
+    static tuning_store_record_t record;
+    tuning_store_request_t request = tuning_store_pending;
+    uint32_t sensor = 0u;
+    uint32_t i;
+    uint32_t j;
+    bool written;
+
+    if (TUNING_STORE_REQUEST_NONE == request)
+    {
+        return;
+    }
+    tuning_store_pending = TUNING_STORE_REQUEST_NONE;
+
+    if (TUNING_STORE_REQUEST_ERASE == request)
+    {
+        written = tuning_store_write(NULL);
+        DEFERRED_LOG1("Tuning profile erased, result %u", written);
+        return;
+    }
+
+    memset(&record, 0, sizeof(record));
+    for (i = 0u; i < CY_CAPSENSE_WIDGET_COUNT; i++)
+    {
+        record.widget[i] = context->ptrWdContext[i];
+
+        for (j = 0u; j < context->ptrWdConfig[i].numSns; j++)
+        {
+            record.idac_comp[sensor++] = context->ptrWdConfig[i].ptrSnsContext[j].idacComp;
+        }
+    }
+
+    record.magic = TUNING_STORE_MAGIC;
+    record.config_id = context->ptrCommonContext->configId;
+    record.size = sizeof(tuning_store_record_t);
+    record.crc = (uint16_t)tuning_store_crc16(0xFFFFu, (const uint8_t *)&record + TUNING_STORE_DATA_OFFSET,
+                                              sizeof(tuning_store_record_t) - TUNING_STORE_DATA_OFFSET);
+
+    written = tuning_store_write(&record);
+    DEFERRED_LOG2("Tuning profile saved to %u flash rows, result %u", TUNING_STORE_ROWS, written);
+}
+#endif /* TUNING_STORE_EN */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * File Name: tuning_store.h
+ *
+ * Description: This file contains the configuration and the interface of
+ * the tuning profile store, which keeps the tuned widget parameters and the
+ * calibrated IDAC values in flash and restores them at startup.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+
+#ifndef TUNING_STORE_H
+#define TUNING_STORE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * User configurable Macros
+ ********************************************************************************/
+/* Keep a tuning profile in flash: the host saves the tuned parameters with a
+ * tuner command, and the firmware restores them at each startup instead of
+ * the design.cycapsense defaults
+ */
+#ifndef TUNING_STORE_EN
+#define TUNING_STORE_EN                 (0u)
+#endif
+
+/* Start of the flash reserved for the profile, up to the end of flash. The
+ * rows are not part of the firmware image, so programming a new image keeps
+ * the profile. The Makefile sets the address of each kit and stops the link
+ * if the image reaches it.
+ */
+#ifndef TUNING_STORE_ADDRESS
+#define TUNING_STORE_ADDRESS            (CY_FLASH_BASE + CY_FLASH_SIZE - 1024u)
+#endif
+
+/* Calibrate the IDACs at startup when no profile has been restored. Set for
+ * designs without IDAC auto-calibration, such as the config_store designs the
+ * Makefile selects with TUNING_STORE=1: Cy_CapSense_Enable() then keeps the
+ * restored IDAC values, and a board without a profile is still calibrated.
+ * Requires the calibration API of the CAPSENSE middleware.
+ */
+#ifndef TUNING_STORE_CALIBRATE
+#define TUNING_STORE_CALIBRATE          (0u)
+#endif
+
+/* Identifies a valid profile in flash */
+#define TUNING_STORE_MAGIC              (0x454E5554UL)  /* "TUNE" */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    TUNING_STORE_REQUEST_NONE,
+    TUNING_STORE_REQUEST_SAVE,      /* Write the current parameters to flash */
+    TUNING_STORE_REQUEST_ERASE      /* Invalidate the profile, boot with the defaults */
+} tuning_store_request_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+#if (0u != TUNING_STORE_EN)
+bool tuning_store_restore(cy_stc_capsense_context_t * context);
+void tuning_store_request(tuning_store_request_t request);
+void tuning_store_process(const cy_stc_capsense_context_t * context);
+#endif
+
+#endif /* TUNING_STORE_H */
+
+
+/* [] END OF FILE */